@@ -0,0 +1,55 @@
+#pragma once
+/*
+ *  File: arena.h
+ *
+ *  Fixed-size bump allocator for the synth's buffers. The arena lives
+ *  inside the Synth object, its size is known at compile time and the
+ *  slices are handed out once at start-up, so nothing allocates on the
+ *  audio thread and the memory footprint can be checked at build time.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+static constexpr size_t k_arena_align = 16;  // NEON-Loads, eine Slice beginnt auf 16 Byte
+static constexpr size_t k_arena_base_align = 64;  // Cache-Line, die erste Slice beginnt darauf
+
+// Auf k_arena_align aufgerundete Größe einer Slice
+constexpr size_t arenaBytes(size_t bytes) {
+  return (bytes + k_arena_align - 1) & ~(k_arena_align - 1);
+}
+
+template <size_t kBytes>
+class StaticArena {
+public:
+  StaticArena(void) : used_(0) {}
+
+  inline void Reset() {
+    used_ = 0;
+  }
+
+  // count Elemente vom Typ T, nullptr, wenn die Arena voll ist
+  template <typename T>
+  inline T * Allocate(size_t count) {
+    const size_t bytes = arenaBytes(count * sizeof(T));
+    if (bytes > kBytes - used_) return nullptr;
+    T * p = reinterpret_cast<T *>(data_ + used_);
+    used_ += bytes;
+    return p;
+  }
+
+  inline size_t Used() const {
+    return used_;
+  }
+
+  static constexpr size_t Capacity() {
+    return kBytes;
+  }
+
+private:
+  size_t used_;
+  alignas(k_arena_base_align) uint8_t data_[kBytes];
+};
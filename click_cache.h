@@ -0,0 +1,177 @@
+#pragma once
+/*
+ *  File: click_cache.h
+ *
+ *  Pre-rendered click transients. A click is fully defined by its tone
+ *  frequency, decay, tone/noise mix, sine tier and noise seed, so it is
+ *  rendered once per parameter set into a slot of a fixed arena and
+ *  replayed from there. The least recently used slot not currently
+ *  playing is recycled for a new parameter set. The key renders its own
+ *  transient, so the fixed-point kernel plugs in an integer key (fixed.h)
+ *  with Q27 samples.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <arm_neon.h>
+
+#include "simd.h"
+#include "sine.h"
+#include "noise.h"
+#include "envelope.h"
+
+// Alles, wovon die Wellenform des Clicks abhängt (ohne Pegel)
+struct ClickKey {
+  typedef float Sample;
+
+  float inc;     // Phaseninkrement des Click-Oszillators pro Sample
+  float dec;     // 1 / Länge der Click-Envelope in Samples
+  float tone;    // 0 = Noise, 1 = tonal
+  uint32_t seed; // Startwert der Noise-Folge
+  uint8_t tier;  // Sinus-Kernel (k_sine_*)
+
+  inline bool operator==(const ClickKey & o) const {
+    return inc == o.inc && dec == o.dec && tone == o.tone && seed == o.seed && tier == o.tier;
+  }
+
+  // Tonal: sin(2 pi n inc), Noise wie NoiseGenerator ab seed, Mischung,
+  // Hochpass src - 0.7 * src[-1] und exponentiell fallende Envelope
+  // (envDecay), die nach 1 / dec Samples bei 0 ankommt. Schreibt die
+  // Länge (Vielfaches von 4, höchstens max_frames) und gibt sie zurück
+  uint32_t Render(float * dst, uint32_t max_frames) const {
+    static const float s_steps[4] = {1.f, 2.f, 3.f, 4.f};
+    static constexpr size_t k_chunk = 64;
+    alignas(16) float tonal[k_chunk];
+    alignas(16) float noise[k_chunk];
+
+    const float frames_f = 1.f / dec;
+    uint32_t length = frames_f < max_frames ? static_cast<uint32_t>(frames_f) + 1 : max_frames;
+    length = (length + 3) & ~3u;
+
+    NoiseGenerator gen;
+    gen.Seed(seed);
+    const float32x4_t steps = vld1q_f32(s_steps);
+    const float32x4_t tone_gain = vdupq_n_f32(tone);
+    const float32x4_t noise_gain = vdupq_n_f32(1.f - tone);
+    const float32x4_t hp_coeff = vdupq_n_f32(0.7f);
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    // Envelope für vier aufeinanderfolgende Samples, ein Schritt = k^4
+    const EnvSegment seg = envDecay(frames_f);
+    const float k4 = envPow(seg.k, 4);
+    const float32x4_t k_env = vdupq_n_f32(k4);
+    const float32x4_t b_env = vdupq_n_f32(seg.target * (1.f - k4));
+    alignas(16) const float first[4] = {envStep(seg, 1.f, 1), envStep(seg, 1.f, 2), envStep(seg, 1.f, 3), envStep(seg, 1.f, 4)};
+    float32x4_t env = vld1q_f32(first);
+    float32x4_t prev = zero;
+    for (size_t base = 0; base < length; base += k_chunk) {
+      const size_t n = length - base < k_chunk ? length - base : k_chunk;
+      for (size_t i = 0; i < n; i += 4) {
+        const float32x4_t idx = vaddq_f32(vdupq_n_f32(static_cast<float>(base + i)), steps);
+        vst1q_f32(tonal + i, vfrac_f32(vmulq_n_f32(idx, inc)));
+      }
+      sineBlockTier(tier, tonal, tonal, n);
+      gen.Render(noise, n);
+      for (size_t i = 0; i < n; i += 4) {
+        const float32x4_t src = vmlaq_f32(vmulq_f32(vld1q_f32(tonal + i), tone_gain), vld1q_f32(noise + i), noise_gain);
+        const float32x4_t hp = vmlsq_f32(src, vshiftin_f32(prev, src), hp_coeff);
+        prev = src;
+        vst1q_f32(dst + base + i, vmulq_f32(hp, vmaxq_f32(env, zero)));
+        env = vmlaq_f32(b_env, env, k_env);
+      }
+    }
+    return length;
+  }
+};
+
+// kSlots Transienten zu höchstens kMaxFrames Samples (Key::Sample). Hinter
+// jedem Slot liegen kPadFrames Nullen, ein Block darf also über das Ende
+// hinaus lesen. Den Speicher (k_storage_samples, 16 Byte ausgerichtet)
+// übergibt Init().
+template <size_t kSlots, size_t kMaxFrames, size_t kPadFrames, typename Key = ClickKey>
+class ClickCache {
+  static_assert(kSlots <= 32, "busy ist eine 32-Bit-Maske");
+  static_assert(kMaxFrames % 4 == 0 && kPadFrames % 4 == 0, "Key::Render() schreibt ganze Vektoren");
+
+public:
+  typedef typename Key::Sample Sample;
+
+  static constexpr size_t k_slot_size = kMaxFrames + kPadFrames;
+  static constexpr size_t k_storage_samples = kSlots * k_slot_size + kPadFrames;  // Slots + Stille
+
+  ClickCache(void) : data_(nullptr), silence_(nullptr) {
+    Reset();
+  }
+
+  inline void Init(Sample * storage) {
+    data_ = storage;
+    silence_ = storage + kSlots * k_slot_size;
+    std::memset(silence_, 0, kPadFrames * sizeof(Sample));
+    Reset();
+  }
+
+  // Verwirft alle Slots
+  inline void Reset() {
+    std::memset(length_, 0, sizeof(length_));
+    std::memset(stamp_, 0, sizeof(stamp_));
+    std::memset(valid_, 0, sizeof(valid_));
+    clock_ = 0;
+  }
+
+  // Slot mit dem Transienten zu key, rendert bei Bedarf in den am längsten
+  // unbenutzten Slot. busy: Bit s = Slot s wird gerade abgespielt.
+  size_t Acquire(const Key & key, uint32_t busy) {
+    ++clock_;
+    for (size_t s = 0; s < kSlots; ++s) {
+      if (valid_[s] && key_[s] == key) {
+        stamp_[s] = clock_;
+        return s;
+      }
+    }
+    size_t victim = kSlots;
+    for (size_t s = 0; s < kSlots; ++s) {
+      if (busy & (1u << s)) continue;
+      if (victim == kSlots || !valid_[s] || (valid_[victim] && stamp_[s] < stamp_[victim])) victim = s;
+    }
+    if (victim == kSlots) victim = 0;  // Nur bei kSlots <= Stimmen möglich
+    render(victim, key);
+    return victim;
+  }
+
+  inline const Sample * Data(size_t slot) const {
+    return data_ + slot * k_slot_size;
+  }
+
+  inline uint32_t Length(size_t slot) const {
+    return length_[slot];
+  }
+
+  // kPadFrames Nullen für Stimmen ohne Click
+  inline const Sample * Silence() const {
+    return silence_;
+  }
+
+private:
+  void render(size_t slot, const Key & key) {
+    Sample * dst = data_ + slot * k_slot_size;
+    const uint32_t length = key.Render(dst, kMaxFrames);
+    std::memset(dst + length, 0, (k_slot_size - length) * sizeof(Sample));
+
+    key_[slot] = key;
+    length_[slot] = length;
+    valid_[slot] = true;
+    stamp_[slot] = clock_;
+  }
+
+  Key key_[kSlots];
+  uint32_t length_[kSlots];
+  uint32_t stamp_[kSlots];  // clock_ beim letzten Zugriff (LRU)
+  bool valid_[kSlots];
+  uint32_t clock_;
+  Sample * data_;     // kSlots * k_slot_size
+  Sample * silence_;  // kPadFrames Nullen
+};
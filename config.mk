@@ -7,3 +7,36 @@ PROJECT_TYPE = synth
 # Source files
 CSRC = header.c
 CXXSRC = unit.cc
+
+# CPU load meter on parameter 24 ("CPU LOAD"), keep at no for release builds
+KICK_PERF_STATS ?= no
+ifeq ($(KICK_PERF_STATS),yes)
+  UDEFS += -DKICK_PERF_STATS
+endif
+
+# Drive saturator: pade, cubic or table (see saturate.h)
+KICK_SATURATOR ?= pade
+UDEFS += -DKICK_SATURATOR=k_saturator_$(KICK_SATURATOR)
+
+# Freeze mode (Synth::setFreeze, freeze.h): no unit parameter reaches it, so
+# the unit builds without it and saves the 200 KB recording buffer
+KICK_FREEZE ?= no
+ifeq ($(KICK_FREEZE),yes)
+  UDEFS += -DKICK_FREEZE
+endif
+
+# Stereo spread of click and OSC2 (Synth::setSpread, spread.h): like freeze
+# host and library only, the unit builds without the delay line
+KICK_SPREAD ?= no
+ifeq ($(KICK_SPREAD),yes)
+  UDEFS += -DKICK_SPREAD
+endif
+
+# Sample offsets for note events are host-only (host/Makefile sets
+# KICK_NOTE_OFFSETS): the runtime passes no timestamp to unit_note_on
+
+# Render kernel: float or fixed (Q-format integer chain, see fixed.h)
+KICK_KERNEL ?= float
+ifeq ($(KICK_KERNEL),fixed)
+  UDEFS += -DKICK_FIXED_POINT
+endif
@@ -0,0 +1,61 @@
+#pragma once
+/*
+ *  File: envelope.h
+ *
+ *  Exponential envelope segments. A segment is the one-pole recursion
+ *  x -> x * k + b, aimed at a target just beyond its end value, so it
+ *  arrives there after the set time with a finite slope instead of
+ *  creeping towards it forever. k and b are derived once per parameter
+ *  change; the n-sample step has the closed form t + (x - t) * k^n, which
+ *  lets the renderer predict state changes for a whole block.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cmath>
+
+static constexpr float k_env_undershoot = 1e-3f;   // Abfall zielt auf -0.001: -60 dB-Kurve, endet exakt bei 0
+static constexpr float k_env_attack_target = 1.5f; // Anstieg zielt auf 1.5 und erreicht 1 nach der Attack-Zeit
+
+struct EnvSegment {
+  float k;       // Faktor pro Sample
+  float b;       // target * (1 - k)
+  float target;  // Fixpunkt der Rekursion
+};
+
+// Segment, das in frames Samples von from nach to läuft. frames < 1 springt
+// im ersten Sample aufs Ziel
+inline EnvSegment envSegment(float frames, float from, float to, float target) {
+  EnvSegment s;
+  s.k = frames >= 1.f ? std::pow((to - target) / (from - target), 1.f / frames) : 0.f;
+  s.b = target * (1.f - s.k);
+  s.target = target;
+  return s;
+}
+
+// 1 -> 0 (Decay, Release, Pitch, OSC2, Click)
+inline EnvSegment envDecay(float frames) {
+  return envSegment(frames, 1.f, 0.f, -k_env_undershoot);
+}
+
+// 0 -> 1 (Attack)
+inline EnvSegment envAttack(float frames) {
+  return envSegment(frames, 0.f, 1.f, k_env_attack_target);
+}
+
+// k^n durch Quadrieren, n ist höchstens eine Blocklänge
+inline float envPow(float k, size_t n) {
+  float r = 1.f;
+  for (; n; n >>= 1) {
+    if (n & 1) r *= k;
+    k *= k;
+  }
+  return r;
+}
+
+// Wert nach n Samples ab x (geschlossene Form)
+inline float envStep(const EnvSegment & s, float x, size_t n) {
+  return s.target + (x - s.target) * envPow(s.k, n);
+}
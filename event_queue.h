@@ -0,0 +1,48 @@
+#pragma once
+/*
+ *  File: event_queue.h
+ *
+ *  Lock-free single-producer/single-consumer ring for events from the unit
+ *  callbacks to the render thread. Neither side ever blocks; Push() fails
+ *  when the ring is full. Exactly one thread may push to a given ring;
+ *  callbacks that may come from different threads need separate rings
+ *  (Synth::postEvent).
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t kCapacity>
+class SpscQueue {
+  static_assert((kCapacity & (kCapacity - 1)) == 0, "Kapazität muss eine Zweierpotenz sein");
+
+public:
+  SpscQueue(void) : head_(0), tail_(0) {}
+
+  // Nur vom Producer (UI) aufrufen
+  inline bool Push(const T & item) {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == kCapacity) return false;
+    items_[tail & (kCapacity - 1)] = item;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Nur vom Consumer (Render-Thread) aufrufen
+  inline bool Pop(T & item) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    item = items_[head & (kCapacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  std::atomic<uint32_t> head_;  // Schreibt nur der Consumer
+  std::atomic<uint32_t> tail_;  // Schreibt nur der Producer
+  T items_[kCapacity];
+};
@@ -0,0 +1,54 @@
+#pragma once
+/*
+ *  File: filter.h
+ *
+ *  Cutoff-to-coefficient table for the TPT (zero-delay feedback) ladder
+ *  filter. The CUTOFF parameter maps exponentially onto 20 Hz .. 20 kHz;
+ *  the table holds the one-pole gain G = g / (1 + g) with the prewarped
+ *  g = tan(pi * fc / fs), so no tan() runs at render time.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sine.h"      // constexprSin
+#include "saturate.h"  // constexprExp
+
+static constexpr float k_filter_min_hz = 20.f;
+static constexpr float k_filter_max_hz = 20000.f;
+static constexpr float k_filter_max_k = 3.8f;  // Resonanz, 4 wäre Selbstoszillation (4 Pole)
+
+static constexpr size_t k_filter_table_size = 128;  // Intervalle, Tabelle hat size + 1 Punkte
+
+struct FilterTable {
+  float g[k_filter_table_size + 1];
+};
+
+constexpr double constexprTan(double x) {
+  return constexprSin(x) / constexprSin(x + 1.57079632679489661923);
+}
+
+constexpr FilterTable makeFilterTable(double samplerate) {
+  FilterTable table{};
+  const double ln_range = 6.90775527898213705205;  // ln(k_filter_max_hz / k_filter_min_hz)
+  for (size_t i = 0; i <= k_filter_table_size; ++i) {
+    const double fc = k_filter_min_hz * constexprExp(ln_range * i / k_filter_table_size);
+    const double g = constexprTan(3.14159265358979323846 * fc / samplerate);
+    table.g[i] = static_cast<float>(g / (1.0 + g));
+  }
+  return table;
+}
+
+static constexpr FilterTable s_filter_table = makeFilterTable(48000.0);
+
+// G für cutoff in [0, 1], linear zwischen den Tabellenpunkten
+inline float filterGain(float cutoff) {
+  const float x = (cutoff < 0.f ? 0.f : (cutoff > 1.f ? 1.f : cutoff)) * k_filter_table_size;
+  int32_t i = static_cast<int32_t>(x);
+  if (i > static_cast<int32_t>(k_filter_table_size) - 1) i = k_filter_table_size - 1;
+  const float frac = x - i;
+  return s_filter_table.g[i] + frac * (s_filter_table.g[i + 1] - s_filter_table.g[i]);
+}
@@ -0,0 +1,300 @@
+#pragma once
+/*
+ *  File: fixed.h
+ *
+ *  Q-format primitives for the fixed-point render kernel (build with
+ *  KICK_KERNEL=fixed, see config.mk). Phases are Q32 and wrap around on
+ *  their own, envelopes and coefficients up to 1 are Q31, audio and gains
+ *  above 1 are Q27 (16x headroom). Every operation saturates.
+ *  Coefficients come from integer math as well: envelope segments from
+ *  an integer exp() series, the cutoff from a Q31 copy of the filter
+ *  table, the click transient from an integer key. Nothing between a
+ *  parameter value and the output sample touches float or libm, so the
+ *  output is bit-exact across compilers, optimisation levels and
+ *  targets. Only the final Q27 -> float store of the unit API rounds,
+ *  to nearest, the same way on every target.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include <arm_neon.h>
+
+#include "simd.h"
+#include "sine.h"
+#include "noise.h"
+#include "saturate.h"
+#include "filter.h"
+#include "envelope.h"
+
+static constexpr int k_q_audio_bits = 27;  // Audio und Verstärkungen > 1: Q27, Bereich ±16
+
+// Konstanten werden zur Übersetzungszeit gerundet, nie zur Laufzeit
+constexpr int32_t q31(double x) {
+  return x >= 1.0 ? INT32_MAX : static_cast<int32_t>(x * 2147483648.0 + (x < 0.0 ? -0.5 : 0.5));
+}
+
+constexpr int32_t q27(double x) {
+  return x >= 16.0 ? INT32_MAX : static_cast<int32_t>(x * 134217728.0 + (x < 0.0 ? -0.5 : 0.5));
+}
+
+inline int32_t sat32(int64_t x) {
+  return x > INT32_MAX ? INT32_MAX : (x < INT32_MIN ? INT32_MIN : static_cast<int32_t>(x));
+}
+
+// Skalare Gegenstücke zu vqaddq_s32, vqrdmulhq_s32 und vmulq_q27
+inline int32_t qadd(int32_t a, int32_t b) {
+  return sat32(static_cast<int64_t>(a) + b);
+}
+
+inline int32_t qrdmulh(int32_t a, int32_t b) {
+  return sat32((static_cast<int64_t>(a) * b + (1ll << 30)) >> 31);
+}
+
+inline int32_t mulQ27(int32_t a, int32_t b) {
+  return sat32(static_cast<int64_t>(qrdmulh(a, b)) << 4);
+}
+
+// Q27 * Q27 -> Q27
+fast_inline int32x4_t vmulq_q27(int32x4_t a, int32x4_t b) {
+  return vqshlq_n_s32(vqrdmulhq_s32(a, b), 4);
+}
+
+// Q31 -> Q27, gerundet
+fast_inline int32x4_t vq27_q31(int32x4_t x) {
+  return vrshrq_n_s32(x, 4);
+}
+
+// dst[i] = start + (i + 1) * (end - start) / len, dst[len - 1] = end
+fast_inline void vramp_s32(int32_t * __restrict dst, int32_t start, int32_t end, size_t len) {
+  const int64_t inc = (static_cast<int64_t>(end) - start) / static_cast<int64_t>(len);
+  for (size_t i = 0; i + 1 < len; ++i) {
+    dst[i] = static_cast<int32_t>(start + inc * static_cast<int64_t>(i + 1));
+  }
+  dst[len - 1] = end;
+}
+
+/*===========================================================================*/
+/* Exponential. */
+/*===========================================================================*/
+
+static constexpr int64_t k_ln2_q31 = 1488522236;    // ln 2
+static constexpr int64_t k_ln3_q31 = 2359251925;    // ln 3, Attack (0 -> 1 mit Ziel 1.5)
+static constexpr int64_t k_ln1001_q31 = 14836437917;  // ln 1001, Abfall (1 -> 0 mit Ziel -0.001)
+
+// e^x, x und Ergebnis Q31 in int64. Taylor-Reihe, bis der Term 0 wird;
+// positive x bis 1.25. Negative x werden halbiert, bis |x| <= 0.5, und
+// das Ergebnis wieder quadriert
+inline int64_t expQ31(int64_t x) {
+  int halvings = 0;
+  while (x < -(1ll << 30)) {
+    x /= 2;
+    ++halvings;
+  }
+  int64_t term = 1ll << 31;
+  int64_t sum = term;
+  for (int64_t n = 1; term != 0; ++n) {
+    term = ((term * x + (1ll << 30)) >> 31) / n;
+    sum += term;
+  }
+  for (; halvings > 0; --halvings) {
+    sum = (sum * sum + (1ll << 30)) >> 31;
+  }
+  return sum;
+}
+
+/*===========================================================================*/
+/* Envelope Segments. */
+/*===========================================================================*/
+
+// Wie EnvSegment (envelope.h) in Q31, Rekursion env * k + b mit vqrdmulh
+struct EnvSegmentQ {
+  int32_t k;  // Faktor pro Sample
+  int32_t b;  // target * (1 - k)
+};
+
+// k = (1 / ratio)^(1 / frames) = e^(-ln(ratio) / frames), frames Q16;
+// unter einem Sample 0 (Sprung im ersten Sample)
+inline int64_t envFactorQ31(int64_t ln_ratio_q31, uint32_t frames_q16) {
+  if (frames_q16 < (1u << 16)) return 0;
+  const int64_t k = expQ31(-((ln_ratio_q31 << 16) / frames_q16));
+  return k > INT32_MAX ? INT32_MAX : k;
+}
+
+// Wie envDecay(): 1 -> 0, zielt auf -0.001
+inline EnvSegmentQ envDecayQ(uint32_t frames_q16) {
+  EnvSegmentQ s;
+  const int64_t k = envFactorQ31(k_ln1001_q31, frames_q16);
+  s.k = static_cast<int32_t>(k);
+  s.b = static_cast<int32_t>(-(((1ll << 31) - k + 500) / 1000));
+  return s;
+}
+
+// Wie envAttack(): 0 -> 1, zielt auf 1.5 (b sättigt, vqadd erkennt den Gipfel)
+inline EnvSegmentQ envAttackQ(uint32_t frames_q16) {
+  EnvSegmentQ s;
+  const int64_t k = envFactorQ31(k_ln3_q31, frames_q16);
+  s.k = static_cast<int32_t>(k);
+  s.b = sat32(((1ll << 31) - k) * 3 / 2);
+  return s;
+}
+
+/*===========================================================================*/
+/* Filter Cutoff. */
+/*===========================================================================*/
+
+// s_filter_table (filter.h) in Q31, zur Übersetzungszeit gerundet
+struct FilterTableQ31 {
+  int32_t g[k_filter_table_size + 1];
+};
+
+constexpr FilterTableQ31 makeFilterTableQ31() {
+  FilterTableQ31 table{};
+  for (size_t i = 0; i <= k_filter_table_size; ++i) {
+    table.g[i] = q31(s_filter_table.g[i]);
+  }
+  return table;
+}
+
+static constexpr FilterTableQ31 s_filter_table_q31 = makeFilterTableQ31();
+
+// Wie filterGain(), cutoff 0 .. 1 in Q16 -> G in Q31
+inline int32_t filterGainQ31(int32_t cutoff_q16) {
+  const int32_t c = cutoff_q16 < 0 ? 0 : (cutoff_q16 > (1 << 16) ? (1 << 16) : cutoff_q16);
+  const int32_t x = c * static_cast<int32_t>(k_filter_table_size);
+  int32_t i = x >> 16;
+  if (i > static_cast<int32_t>(k_filter_table_size) - 1) i = k_filter_table_size - 1;
+  const int64_t frac = x - (i << 16);
+  const int64_t d = static_cast<int64_t>(s_filter_table_q31.g[i + 1]) - s_filter_table_q31.g[i];
+  return static_cast<int32_t>(s_filter_table_q31.g[i] + ((d * frac + (1 << 15)) >> 16));
+}
+
+/*===========================================================================*/
+/* Sine. */
+/*===========================================================================*/
+
+// Minimax-Polynom von sinePoly<7> (sine.h), umgerechnet auf u = 4 m in
+// [-1, 1] und halbiert, damit der lineare Koeffizient (pi/2) in Q31 passt
+static constexpr int32_t k_sine_q31_c[4] = {
+  q31(k_sine_poly7_c[0] / 8.0), q31(k_sine_poly7_c[1] / 128.0),
+  q31(k_sine_poly7_c[2] / 2048.0), q31(k_sine_poly7_c[3] / 32768.0)
+};
+
+// sin(2 pi phase), phase Q32 -> Q31. Die Phase als int32 liegt in
+// [-0.5, 0.5) Perioden; die äußeren Viertel werden auf [-0.25, 0.25]
+// gespiegelt (0.5 - p bzw. -0.5 - p, beides 2^31 - p modulo 2^32)
+fast_inline int32x4_t vsine_q31(uint32x4_t phase) {
+  const int32x4_t s = vreinterpretq_s32_u32(phase);
+  const uint32x4_t outer = vcltq_s32(veorq_s32(s, vshlq_n_s32(s, 1)), vdupq_n_s32(0));
+  const int32x4_t m = vbslq_s32(outer, vreinterpretq_s32_u32(vsubq_u32(vdupq_n_u32(0x80000000u), phase)), s);
+  const int32x4_t u = vqshlq_n_s32(m, 1);  // Viertelperiode = 1
+  const int32x4_t u2 = vqrdmulhq_s32(u, u);
+  int32x4_t y = vqaddq_s32(vdupq_n_s32(k_sine_q31_c[2]), vqrdmulhq_n_s32(u2, k_sine_q31_c[3]));
+  y = vqaddq_s32(vdupq_n_s32(k_sine_q31_c[1]), vqrdmulhq_s32(u2, y));
+  y = vqaddq_s32(vdupq_n_s32(k_sine_q31_c[0]), vqrdmulhq_s32(u2, y));
+  return vqshlq_n_s32(vqrdmulhq_s32(u, y), 1);
+}
+
+inline int32_t sineQ31(uint32_t phase) {
+  return vgetq_lane_s32(vsine_q31(vdupq_n_u32(phase)), 0);
+}
+
+/*===========================================================================*/
+/* Saturator. */
+/*===========================================================================*/
+
+static constexpr size_t k_tanh_q31_size = 256;  // Stützstellen auf [0, 8), Schritt 1/32
+
+// Wert und Steigung zum nächsten Punkt nebeneinander, wie TanhTable
+struct TanhTableQ31 {
+  int32_t data[k_tanh_q31_size * 2];
+};
+
+constexpr TanhTableQ31 makeTanhTableQ31() {
+  TanhTableQ31 table{};
+  for (size_t i = 0; i < k_tanh_q31_size; ++i) {
+    const double y0 = constexprTanh(i / 32.0);
+    const double y1 = constexprTanh((i + 1) / 32.0);
+    table.data[2 * i] = q31(y0);
+    table.data[2 * i + 1] = q31(y1 - y0);
+  }
+  return table;
+}
+
+static constexpr TanhTableQ31 s_tanh_table_q31 = makeTanhTableQ31();
+
+// tanh(x), x Q27 -> Q31. Über |x| = 8 (tanh = 1 - 2e-7) begrenzt; Index
+// sind die oberen 8 Bit von |x|, die unteren 22 der Interpolationsanteil
+fast_inline int32x4_t vtanh_q31(int32x4_t x) {
+  const int32x4_t a = vminq_s32(vqabsq_s32(x), vdupq_n_s32((8 << k_q_audio_bits) - 1));
+  const int32x4_t frac = vshlq_n_s32(vandq_s32(a, vdupq_n_s32((1 << 22) - 1)), 9);
+  alignas(16) int32_t index[4];
+  vst1q_s32(index, vshrq_n_s32(a, 22));
+  alignas(16) int32_t y0[4];
+  alignas(16) int32_t d[4];
+  for (size_t k = 0; k < 4; ++k) {
+    y0[k] = s_tanh_table_q31.data[2 * index[k]];
+    d[k] = s_tanh_table_q31.data[2 * index[k] + 1];
+  }
+  const int32x4_t y = vqaddq_s32(vld1q_s32(y0), vqrdmulhq_s32(vld1q_s32(d), frac));
+  return vbslq_s32(vcltq_s32(x, vdupq_n_s32(0)), vnegq_s32(y), y);
+}
+
+/*===========================================================================*/
+/* Click. */
+/*===========================================================================*/
+
+// ClickKey (click_cache.h) für den Festkomma-Kernel: Parameter ganzzahlig,
+// der Transient in Q27. Sinus immer als Polynom 7. Grades
+struct ClickKeyQ {
+  typedef int32_t Sample;
+
+  uint32_t inc;     // Phaseninkrement Q32
+  uint32_t frames;  // Länge der Click-Envelope in Samples, Q16
+  int32_t tone;     // Q31, 0 = Noise, 1 = tonal
+  uint32_t seed;    // Noise-Folge
+
+  inline bool operator==(const ClickKeyQ & o) const {
+    return inc == o.inc && frames == o.frames && tone == o.tone && seed == o.seed;
+  }
+
+  // Wie ClickKey::Render(): sin(2 pi n inc), Noise ab seed, Mischung,
+  // Hochpass src - 0.7 * src[-1], Envelope envDecayQ() ab dem ersten Schritt
+  uint32_t Render(int32_t * dst, uint32_t max_frames) const {
+    const uint32_t whole = frames >> 16;
+    uint32_t length = whole < max_frames ? whole + 1 : max_frames;
+    length = (length + 3) & ~3u;
+
+    NoiseGenerator gen;
+    gen.Seed(seed);
+    const EnvSegmentQ seg = envDecayQ(frames);
+    const int32x4_t tone_gain = vdupq_n_s32(tone);
+    const int32x4_t noise_gain = vdupq_n_s32(sat32((1ll << 31) - tone));
+    const int32x4_t hp_coeff = vdupq_n_s32(q31(0.7));
+    alignas(16) const uint32_t steps[4] = {inc, 2 * inc, 3 * inc, 4 * inc};
+    uint32x4_t phase = vld1q_u32(steps);
+    const uint32x4_t phase_step = vdupq_n_u32(4 * inc);
+    int32x4_t prev = vdupq_n_s32(0);
+    int32_t env = INT32_MAX;
+    for (uint32_t i = 0; i < length; i += 4) {
+      alignas(16) int32_t noise[4];
+      alignas(16) int32_t gain[4];
+      for (size_t k = 0; k < 4; ++k) {
+        noise[k] = gen.NextQ31();
+        env = qadd(qrdmulh(env, seg.k), seg.b);
+        gain[k] = env > 0 ? env : 0;
+      }
+      const int32x4_t mixed = vqaddq_s32(vqrdmulhq_s32(vsine_q31(phase), tone_gain),
+                                         vqrdmulhq_s32(vld1q_s32(noise), noise_gain));
+      const int32x4_t src = vq27_q31(mixed);
+      const int32x4_t hp = vqsubq_s32(src, vqrdmulhq_s32(vextq_s32(prev, src, 3), hp_coeff));
+      prev = src;
+      vst1q_s32(dst + i, vqrdmulhq_s32(hp, vld1q_s32(gain)));
+      phase = vaddq_u32(phase, phase_step);
+    }
+    return length;
+  }
+};
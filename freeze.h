@@ -0,0 +1,131 @@
+#pragma once
+/*
+ *  File: freeze.h
+ *
+ *  Whole-hit sample cache for freeze mode. With fixed parameters a hit is
+ *  a deterministic waveform up to the velocity gain, so the first hit is
+ *  recorded from one voice lane while it plays (before velocity and the
+ *  output limiter) and later hits are replayed from the recording. The
+ *  samples are float, or Q27 int32_t for the fixed-point kernel.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <arm_neon.h>
+
+#include "simd.h"
+
+// Eine Aufnahme zu höchstens kMaxFrames Samples, dahinter kPadFrames Nullen,
+// damit ein Block über das Ende hinaus lesen darf. Den Speicher
+// (k_storage_samples, 16 Byte ausgerichtet) übergibt Init().
+template <size_t kMaxFrames, size_t kPadFrames, typename T = float>
+class HitCache {
+public:
+  typedef T Sample;
+
+  static constexpr size_t k_storage_samples = kMaxFrames + kPadFrames;
+
+  HitCache(void) : length_(0), data_(nullptr) {
+    Invalidate();
+  }
+
+  inline void Init(T * storage) {
+    data_ = storage;
+    length_ = 0;
+    Invalidate();
+  }
+
+  // Verwirft Aufnahme und laufende Aufnahme. Die Daten bleiben bis zur
+  // nächsten Aufnahme lesbar, spielende Stimmen laufen also zu Ende
+  inline void Invalidate() {
+    valid_ = false;
+    recording_ = false;
+  }
+
+  inline bool Valid() const {
+    return valid_;
+  }
+
+  inline bool Recording() const {
+    return recording_;
+  }
+
+  inline void Begin() {
+    valid_ = false;
+    recording_ = true;
+    length_ = 0;
+  }
+
+  // Hängt Lane voice von mix * env an, Puffer im Layout [Frame][Stimme].
+  // false, wenn der Treffer nicht mehr in den Speicher passt
+  inline bool Append(const T * mix, const T * env, size_t voice, size_t frames) {
+    if (length_ + frames > kMaxFrames) {
+      recording_ = false;
+      return false;
+    }
+    T * dst = data_ + length_;
+    for (size_t i = 0; i < frames; ++i) {
+      dst[i] = product(mix[(i << 2) + voice], env[(i << 2) + voice]);
+    }
+    length_ += frames;
+    return true;
+  }
+
+  inline void Finish() {
+    std::memset(data_ + length_, 0, kPadFrames * sizeof(T));
+    recording_ = false;
+    valid_ = true;
+  }
+
+  inline uint32_t Length() const {
+    return length_;
+  }
+
+  // dst[i] += gain * Aufnahme[pos + i], Layout [Frame]
+  inline void Mix(float * __restrict dst, uint32_t pos, float gain, size_t frames) const {
+    const float * src = data_ + pos;
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+      vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), gain));
+    }
+    for (; i < frames; ++i) {
+      dst[i] += gain * src[i];
+    }
+  }
+
+  // Festkomma: Aufnahme und dst Q27, gain Q27, gesättigt wie vmulq_q27 (fixed.h)
+  inline void Mix(int32_t * __restrict dst, uint32_t pos, int32_t gain, size_t frames) const {
+    const int32_t * src = data_ + pos;
+    const int32x4_t g = vdupq_n_s32(gain);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+      const int32x4_t x = vqshlq_n_s32(vqrdmulhq_s32(vld1q_s32(src + i), g), 4);
+      vst1q_s32(dst + i, vqaddq_s32(vld1q_s32(dst + i), x));
+    }
+    for (; i < frames; ++i) {
+      const int32x4_t x = vqshlq_n_s32(vqrdmulhq_s32(vdupq_n_s32(src[i]), g), 4);
+      dst[i] = vgetq_lane_s32(vqaddq_s32(vdupq_n_s32(dst[i]), x), 0);
+    }
+  }
+
+private:
+  static inline float product(float mix, float env) {
+    return mix * env;
+  }
+
+  // Q27 * Q31 -> Q27 wie vqrdmulhq_s32
+  static inline int32_t product(int32_t mix, int32_t env) {
+    if (mix == INT32_MIN && env == INT32_MIN) return INT32_MAX;
+    return static_cast<int32_t>((static_cast<int64_t>(mix) * env + (1ll << 30)) >> 31);
+  }
+
+  uint32_t length_;
+  bool valid_;
+  bool recording_;
+  T * data_;  // k_storage_samples
+};
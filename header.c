@@ -18,8 +18,8 @@ const __unit_header unit_header_t unit_header = {
     .unit_id = 0x0001U,                                    // Id for this unit, should be unique within the scope of a given dev_id
     .version = 0x00010000U,                                // This unit's version: major.minor.patch (major<<16 minor<<8 patch)
     .name = "KICKZ Drum",                                 // Name for this unit, will be displayed on device
-    .num_presets = 5,                                      // Number of internal presets this unit has
-    .num_params = 23,                                      // Jetzt 23 Parameter
+    .num_presets = 5,                                      // Nur Werkspresets; die Benutzer-Slots sind Host-/Bibliotheks-API
+    .num_params = 24,                                      // 23 Parameter + LFO-Tiefe bzw. CPU-Last
     .params = {
         // Format: min, max, center, default, type, fractional, frac. type, <reserved>, name
 
@@ -33,7 +33,7 @@ const __unit_header unit_header_t unit_header = {
         {0, 50, 0, 2, k_unit_param_type_msec, 0, 0, 0, {"ATTACK"}},
         {10, 1000, 10, 300, k_unit_param_type_msec, 0, 0, 0, {"RELEASE"}},
         {0, 100, 0, 50, k_unit_param_type_percent, 0, 0, 0, {"P.CURVE"}},
-        {0, 0, 0, 0, k_unit_param_type_none, 0, 0, 0, {""}}, // Leerparameter
+        {0, 18, 0, 0, k_unit_param_type_strings, 0, 0, 0, {"LFO"}},  // Aus, Pitch/Cutoff/Drive x 1/16 .. 2 Takte
         
         // Page 3 - Click parameters (NEU)
         {0, 100, 0, 50, k_unit_param_type_percent, 0, 0, 0, {"CLICK LVL"}},
@@ -57,4 +57,9 @@ const __unit_header unit_header_t unit_header = {
         {0, 100, 0, 0, k_unit_param_type_percent, 0, 0, 0, {"FM AMOUNT"}},
         {5, 50, 5, 20, k_unit_param_type_none, 1, 1, 0, {"FM RATIO"}},
         {10, 500, 10, 100, k_unit_param_type_msec, 0, 0, 0, {"OSC2 DECAY"}},
-        {0, 0, 0, 0, k_unit_param_type_none, 0, 0, 0, {""}}}};
+#ifdef KICK_PERF_STATS
+        // Die LFO-Tiefe bleibt hier fest bei 50 %, Presets behalten ihre gespeicherte Tiefe
+        {0, 5, 0, 0, k_unit_param_type_strings, 0, 0, 0, {"CPU LOAD"}}}};  // AVG/MAX/MIN/RISK/XRUN/Kosten
+#else
+        {0, 100, 0, 50, k_unit_param_type_percent, 0, 0, 0, {"LFO DEPTH"}}}};
+#endif
@@ -0,0 +1,185 @@
+#pragma once
+/*
+ *  File: host/batch.h
+ *
+ *  Offline batch renderer for sample packs. Renders a list of independent
+ *  kicks (preset, parameter overrides, note, velocity, length) on a pool
+ *  of worker threads, each with its own Synth instance and pre-allocated
+ *  output buffer. Run() hands each finished kick to a callback, Export()
+ *  streams it to a WAV file through the worker's WavWriter. The drumlogue
+ *  unit (unit.cc) does not use this.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "unit.h"
+#include "synth.h"
+#include "wav_writer.h"
+
+static constexpr size_t k_batch_max_params = 8;    // Parameter-Überschreibungen pro Job
+static constexpr size_t k_batch_chunk = 1024;      // Frames pro Render()-Aufruf
+static constexpr size_t k_batch_jobs_per_grab = 4; // Jobs, die ein Worker auf einmal übernimmt
+
+struct BatchParam {
+  uint8_t id;  // Synth::k_param_* (setParameter)
+  int32_t value;
+};
+
+// Ein Kick: Preset, danach die Überschreibungen, dann ein Anschlag ab Frame 0
+struct BatchJob {
+  uint8_t preset;
+  uint8_t note;
+  uint8_t velocity;
+  uint8_t num_params;
+  BatchParam params[k_batch_max_params];
+  uint32_t frames;  // Länge der Ausgabe, höchstens max_frames des Renderers
+  uint32_t seed;    // Noise-Seed (Synth::Reset)
+};
+
+// Fertiger Job: frames Mono-Samples im Puffer des Workers, gültig bis zum
+// Rücksprung. Läuft im Worker-Thread, muss also threadsicher sein
+typedef void (*BatchSink)(void * user, size_t job, const float * mono, size_t frames);
+
+// Dateiname für Job job nach path (len Bytes), false: Job überspringen.
+// Läuft im Worker-Thread
+typedef bool (*BatchPath)(void * user, size_t job, char * path, size_t len);
+
+class BatchRenderer {
+public:
+  // threads = 0: einer pro Kern
+  BatchRenderer(size_t threads, size_t max_frames) : max_frames_(max_frames) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    for (size_t t = 0; t < threads; ++t) {
+      std::unique_ptr<Worker> w(new Worker);
+      // Synth ist auf Cache-Lines ausgerichtet, ein einfaches new garantiert
+      // das vor C++17 nicht
+      void * mem = nullptr;
+      if (posix_memalign(&mem, k_arena_base_align, sizeof(Synth)) != 0) throw std::bad_alloc();
+      w->synth = new (mem) Synth();
+      w->mono.resize(max_frames);
+      workers_.push_back(std::move(w));
+    }
+  }
+
+  ~BatchRenderer(void) {
+    for (std::unique_ptr<Worker> & w : workers_) {
+      w->synth->~Synth();
+      std::free(w->synth);
+    }
+  }
+
+  BatchRenderer(const BatchRenderer &) = delete;
+  BatchRenderer & operator=(const BatchRenderer &) = delete;
+
+  inline size_t Threads() const {
+    return workers_.size();
+  }
+
+  inline size_t MaxFrames() const {
+    return max_frames_;
+  }
+
+  // Rendert alle Jobs und kehrt zurück, wenn sink für jeden aufgerufen wurde.
+  // Die Reihenfolge der Aufrufe ist nicht festgelegt, das Ergebnis eines
+  // Jobs hängt aber nicht davon ab, welcher Worker ihn rechnet
+  void Run(const BatchJob * jobs, size_t count, BatchSink sink, void * user) {
+    forEachJob(count, [&](Worker & w, size_t j) {
+      const size_t frames = render(w, jobs[j]);
+      sink(user, j, w.mono.data(), frames);
+    });
+  }
+
+  // Wie Run(), schreibt jeden Job aber direkt aus RenderMono() in eine
+  // Mono-WAV-Datei (k_wav_*). Liefert die Zahl der fehlgeschlagenen Dateien
+  size_t Export(const BatchJob * jobs, size_t count, BatchPath path, void * user, uint8_t format) {
+    std::atomic<size_t> failures(0);
+    forEachJob(count, [&](Worker & w, size_t j) {
+      char name[512];
+      if (!path(user, j, name, sizeof(name))) return;
+      if (!w.writer.Open(name, 1, format)) {
+        failures.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      start(w, jobs[j]);
+      const size_t frames = jobs[j].frames;
+      for (size_t pos = 0; pos < frames;) {
+        size_t n = frames - pos < k_batch_chunk ? frames - pos : k_batch_chunk;
+        float * dst = w.writer.Acquire(n);
+        w.synth->RenderMono(dst, n);
+        w.writer.Commit(n);
+        pos += n;
+      }
+      if (!w.writer.Close()) failures.fetch_add(1, std::memory_order_relaxed);
+    });
+    return failures.load();
+  }
+
+private:
+  struct Worker {
+    Synth * synth;
+    std::vector<float> mono;  // max_frames_
+    WavWriter writer;
+  };
+
+  // fn(worker, job) für alle Jobs, verteilt über die Worker
+  template <typename Fn>
+  void forEachJob(size_t count, Fn fn) {
+    std::atomic<size_t> next(0);
+    auto work = [this, count, &fn, &next](Worker & w) {
+      for (;;) {
+        const size_t first = next.fetch_add(k_batch_jobs_per_grab, std::memory_order_relaxed);
+        if (first >= count) return;
+        const size_t last = first + k_batch_jobs_per_grab < count ? first + k_batch_jobs_per_grab : count;
+        for (size_t j = first; j < last; ++j) fn(w, j);
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(workers_.size() - 1);
+    for (size_t t = 1; t < workers_.size(); ++t) {
+      threads.emplace_back([&work, this, t] { work(*workers_[t]); });
+    }
+    work(*workers_[0]);  // Der aufrufende Thread rechnet mit
+    for (std::thread & th : threads) th.join();
+  }
+
+  // Bereitet den Anschlag von job vor, Render ab Frame 0 liefert den Kick
+  void start(Worker & w, const BatchJob & job) {
+    Synth & synth = *w.synth;
+    synth.LoadPreset(job.preset);
+    const size_t num_params = job.num_params < k_batch_max_params ? job.num_params : k_batch_max_params;
+    for (size_t i = 0; i < num_params; ++i) {
+      synth.setParameter(job.params[i].id, job.params[i].value);
+    }
+    synth.Reset(job.seed);
+    // Ein Frame ohne Stimme übernimmt die Ereignisse und setzt die Glättung
+    // ans Ziel, so startet der Anschlag unabhängig vom vorigen Job
+    float discard;
+    synth.RenderMono(&discard, 1);
+    synth.NoteOn(job.note, job.velocity);
+  }
+
+  size_t render(Worker & w, const BatchJob & job) {
+    start(w, job);
+    const size_t frames = job.frames < max_frames_ ? job.frames : max_frames_;
+    float * mono = w.mono.data();
+    for (size_t pos = 0; pos < frames; pos += k_batch_chunk) {
+      const size_t n = frames - pos < k_batch_chunk ? frames - pos : k_batch_chunk;
+      w.synth->RenderMono(mono + pos, n);
+    }
+    return frames;
+  }
+
+  size_t max_frames_;
+  std::vector<std::unique_ptr<Worker>> workers_;  // WavWriter ist nicht verschiebbar
+};
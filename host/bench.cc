@@ -0,0 +1,328 @@
+/*
+ *  File: host/bench.cc
+ *
+ *  Offline benchmark for Synth::Render. Runs every preset at several block
+ *  sizes with a retriggered kick and reports ns/frame, cycles/frame and the
+ *  worst-case block time, then every preset at 1x/2x/4x drive oversampling,
+ *  with the stereo spread off and on, and the OSC2 waveform kernels naive
+ *  against band-limited. Last, the accuracy of every sine tier against
+ *  std::sin (max error and THD over 2^16 points).
+ *  Cycles come from the perf cycle counter when the
+ *  kernel allows it (Linux, perf_event_paranoid <= 2), otherwise "n/a".
+ *
+ *  Usage: bench [seconds per run] [retrigger interval in ms]
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "unit.h"
+#include "synth.h"
+
+static constexpr size_t k_block_sizes[] = {32, 64, 128};
+static constexpr size_t k_max_block = 128;
+static constexpr uint8_t k_num_presets = 5;
+
+/*===========================================================================*/
+/* Timing. */
+/*===========================================================================*/
+
+static inline uint64_t nowNs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+// CPU-Zyklen des eigenen Threads über perf, -1 wenn nicht verfügbar
+class CycleCounter {
+public:
+  CycleCounter() : fd_(-1) {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  ~CycleCounter() {
+#ifdef __linux__
+    if (fd_ >= 0) close(fd_);
+#endif
+  }
+
+  bool valid() const { return fd_ >= 0; }
+
+  void start() {
+#ifdef __linux__
+    if (fd_ < 0) return;
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  uint64_t stop() {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (fd_ < 0) return 0;
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd_, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+    return count;
+  }
+
+private:
+  int fd_;
+};
+
+/*===========================================================================*/
+/* Benchmark. */
+/*===========================================================================*/
+
+struct Result {
+  double ns_per_frame;
+  double cycles_per_frame;  // < 0 ohne Zähler
+  double worst_block_us;
+  double worst_load;        // schlechtester Block relativ zur Echtzeit
+};
+
+// os < 0: Oversampling des Presets, sonst k_os_*; spread: Stereo-Breite in %
+static Result run(Synth & synth, CycleCounter & counter, uint8_t preset, size_t block,
+                  float seconds, float retrigger_ms, int os = -1, uint8_t spread = 0) {
+  alignas(16) static float out[k_max_block * 2];
+
+  unit_runtime_desc_t desc;
+  std::memset(&desc, 0, sizeof(desc));
+  desc.target = UNIT_TARGET_PLATFORM;
+  desc.api = UNIT_API_VERSION;
+  desc.samplerate = 48000;
+  desc.frames_per_buffer = static_cast<uint16_t>(block);
+  desc.output_channels = 2;
+  synth.Init(&desc);
+  synth.LoadPreset(preset);
+  if (os >= 0) synth.setOversampling(static_cast<uint8_t>(os));
+#ifdef KICK_SPREAD
+  synth.setSpread(spread);
+#else
+  (void)spread;
+#endif
+  synth.Reset();
+
+  const size_t total = static_cast<size_t>(seconds * k_samplerate);
+  const size_t retrigger = static_cast<size_t>(retrigger_ms * 0.001f * k_samplerate);
+  size_t next_note = 0;
+  uint64_t elapsed_ns = 0;
+  uint64_t worst_ns = 0;
+  uint64_t cycles = 0;
+  float sink = 0.f;
+
+  for (size_t pos = 0; pos < total; pos += block) {
+    if (pos >= next_note) {
+      synth.NoteOn(36, 100);
+      next_note += retrigger;
+    }
+    counter.start();
+    const uint64_t t0 = nowNs();
+    synth.Render(out, block);
+    const uint64_t dt = nowNs() - t0;
+    cycles += counter.stop();
+    elapsed_ns += dt;
+    if (dt > worst_ns) worst_ns = dt;
+    sink += out[0];
+  }
+
+  // Ergebnis verwenden, damit der Compiler nichts wegoptimiert
+  if (sink == 12345.f) std::puts("");
+
+  const size_t frames = (total / block) * block + (total % block ? block : 0);
+  Result r;
+  r.ns_per_frame = static_cast<double>(elapsed_ns) / frames;
+  r.cycles_per_frame = counter.valid() ? static_cast<double>(cycles) / frames : -1.0;
+  r.worst_block_us = worst_ns * 1e-3;
+  r.worst_load = worst_ns * 1e-9 / (block * static_cast<double>(k_inv_samplerate));
+  return r;
+}
+
+// OSC2-Kernel allein, naiv gegen bandbegrenzt: ns pro Frame (4 Stimmen)
+// über einen Block mit k_block_size Frames und wechselnder Tonhöhe
+template <int kKernel, bool kBandlimited>
+static double runOscKernel(float seconds) {
+  static constexpr size_t k_lanes = k_block_size * k_num_voices;
+  alignas(16) static float phase[k_lanes];
+  alignas(16) static float inc[k_lanes];
+  alignas(16) static float out[k_lanes];
+  for (size_t i = 0; i < k_lanes; ++i) {
+    inc[i] = (50.f + 20.f * (i & 3)) * 6.f * k_inv_samplerate;  // OSC2 bis 6x über dem Körper
+    phase[i] = 0.f;
+  }
+
+  const size_t blocks = static_cast<size_t>(seconds * k_samplerate) / k_block_size;
+  float sink = 0.f;
+  const uint64_t t0 = nowNs();
+  for (size_t b = 0; b < blocks; ++b) {
+    for (size_t i = 0; i < k_lanes; ++i) {
+      const float p = phase[i] + inc[i] * k_block_size;
+      phase[i] = p - static_cast<int>(p);
+    }
+    if (kKernel == k_wave_saw) {
+      sawBlock<kBandlimited>(out, phase, inc, k_lanes);
+    } else if (kKernel == k_wave_triangle) {
+      triangleBlock<kBandlimited>(out, phase, inc, k_lanes);
+    } else {
+      pulseBlock<kBandlimited>(out, phase, inc, k_lanes, 0.5f);
+    }
+    sink += out[b & (k_lanes - 1)];
+  }
+  const uint64_t elapsed = nowNs() - t0;
+  if (sink == 12345.f) std::puts("");
+  return static_cast<double>(elapsed) / (blocks * k_block_size);
+}
+
+// Genauigkeit einer Sinus-Stufe gegen std::sin (double) über eine Periode
+// mit k_sine_points Stützstellen, durch denselben Block-Kernel wie der
+// Renderer. THD: Leistung aller Bins außer der Grundwelle (inkl. DC)
+// relativ zur Grundwelle; die Phasen sind exakt periodisch, also fällt
+// jeder Fehler auf eine Harmonische
+struct SineAccuracy {
+  double max_error;
+  double thd_db;
+};
+
+static constexpr size_t k_sine_points = 1 << 16;
+
+static SineAccuracy measureSine(uint8_t tier) {
+  static float phase[k_sine_points];
+  static float y[k_sine_points];
+  for (size_t i = 0; i < k_sine_points; ++i) {
+    phase[i] = static_cast<float>(i) / k_sine_points;
+  }
+  sineBlockTier(tier, y, phase, k_sine_points);
+
+  const double w = 6.28318530717958647692 / k_sine_points;
+  double max_error = 0.0;
+  double a = 0.0;
+  double b = 0.0;
+  for (size_t i = 0; i < k_sine_points; ++i) {
+    const double e = std::fabs(y[i] - std::sin(w * i));
+    if (e > max_error) max_error = e;
+    a += y[i] * std::cos(w * i);
+    b += y[i] * std::sin(w * i);
+  }
+  a *= 2.0 / k_sine_points;
+  b *= 2.0 / k_sine_points;
+
+  // Rest ohne Grundwelle direkt summieren statt Gesamt- minus
+  // Grundwellenleistung, sonst frisst die Auslöschung die -140 dB
+  double residual = 0.0;
+  for (size_t i = 0; i < k_sine_points; ++i) {
+    const double r = y[i] - (a * std::cos(w * i) + b * std::sin(w * i));
+    residual += r * r;
+  }
+  residual /= k_sine_points;
+  const double fundamental = 0.5 * (a * a + b * b);
+
+  SineAccuracy acc;
+  acc.max_error = max_error;
+  acc.thd_db = 10.0 * std::log10(residual / fundamental);
+  return acc;
+}
+
+static void printResult(const char * name, size_t block, const Result & r) {
+  char cycles[32];
+  if (r.cycles_per_frame < 0.0) {
+    std::snprintf(cycles, sizeof(cycles), "n/a");
+  } else {
+    std::snprintf(cycles, sizeof(cycles), "%.1f", r.cycles_per_frame);
+  }
+  std::printf("%-14s %6zu %10.2f %12s %14.2f %9.2f%%\n", name, block, r.ns_per_frame, cycles,
+              r.worst_block_us, r.worst_load * 100.0);
+}
+
+int main(int argc, char ** argv) {
+  const float seconds = argc > 1 ? static_cast<float>(std::atof(argv[1])) : 10.f;
+  const float retrigger_ms = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 500.f;
+  if (seconds <= 0.f || retrigger_ms <= 0.f) {
+    std::fprintf(stderr, "usage: %s [seconds per run] [retrigger interval in ms]\n", argv[0]);
+    return 1;
+  }
+
+  static Synth synth;
+  CycleCounter counter;
+
+#ifdef KICK_NEON_EMULATED
+  std::printf("# NEON: scalar emulation (timings are not representative of the target)\n");
+#endif
+  if (!counter.valid()) {
+    std::printf("# cycle counter unavailable (perf_event_open failed), reporting n/a\n");
+  }
+  std::printf("# %.1f s per run, retrigger every %.0f ms\n", seconds, retrigger_ms);
+  std::printf("%-14s %6s %10s %12s %14s %10s\n", "preset", "block", "ns/frame", "cycles/frame",
+              "worst block us", "worst load");
+
+  for (uint8_t p = 0; p < k_num_presets; ++p) {
+    for (size_t b = 0; b < sizeof(k_block_sizes) / sizeof(k_block_sizes[0]); ++b) {
+      const size_t block = k_block_sizes[b];
+      printResult(synth.getPresetName(p), block, run(synth, counter, p, block, seconds, retrigger_ms));
+    }
+  }
+
+  // Kosten des Drive-Oversamplings bei Blockgröße 64
+  static const char * const s_os_names[k_num_os_factors] = {"1x", "2x", "4x"};
+  std::printf("\n%-14s %6s %10s %12s %14s %10s\n", "preset/drive", "block", "ns/frame", "cycles/frame",
+              "worst block us", "worst load");
+  for (uint8_t p = 0; p < k_num_presets; ++p) {
+    for (int os = 0; os < k_num_os_factors; ++os) {
+      char name[32];
+      std::snprintf(name, sizeof(name), "%.10s %s", synth.getPresetName(p), s_os_names[os]);
+      printResult(name, 64, run(synth, counter, p, 64, seconds, retrigger_ms, os));
+    }
+  }
+
+#ifdef KICK_SPREAD
+  // Kosten der Stereo-Breite bei Blockgröße 64
+  std::printf("\n%-14s %6s %10s %12s %14s %10s\n", "preset/spread", "block", "ns/frame", "cycles/frame",
+              "worst block us", "worst load");
+  for (uint8_t p = 0; p < k_num_presets; ++p) {
+    for (int on = 0; on < 2; ++on) {
+      char name[32];
+      std::snprintf(name, sizeof(name), "%.10s %s", synth.getPresetName(p), on ? "on" : "off");
+      printResult(name, 64, run(synth, counter, p, 64, seconds, retrigger_ms, -1, on ? 50 : 0));
+    }
+  }
+#endif
+
+  // OSC2-Wellenformen: naiv gegen PolyBLEP/PolyBLAMP
+  std::printf("\n%-14s %12s %12s\n", "osc2 kernel", "naive ns/fr", "blep ns/fr");
+  std::printf("%-14s %12.3f %12.3f\n", "Saw", runOscKernel<k_wave_saw, false>(seconds),
+              runOscKernel<k_wave_saw, true>(seconds));
+  std::printf("%-14s %12.3f %12.3f\n", "Triangle", runOscKernel<k_wave_triangle, false>(seconds),
+              runOscKernel<k_wave_triangle, true>(seconds));
+  std::printf("%-14s %12.3f %12.3f\n", "Pulse", runOscKernel<k_wave_pulse, false>(seconds),
+              runOscKernel<k_wave_pulse, true>(seconds));
+
+  // Sinus-Stufen: Genauigkeit, zitiert in sine.h
+  static const char * const s_tier_names[k_num_sine_tiers] = {"libm", "table", "poly7", "poly5"};
+  std::printf("\n%-14s %12s %12s\n", "sine tier", "max error", "THD dB");
+  for (uint8_t t = 0; t < k_num_sine_tiers; ++t) {
+    const SineAccuracy acc = measureSine(t);
+    std::printf("%-14s %12.2e %12.1f\n", s_tier_names[t], acc.max_error, acc.thd_db);
+  }
+  return 0;
+}
@@ -0,0 +1,558 @@
+/*
+ *  File: host/golden.cc
+ *
+ *  Golden-output regression check for the render path. Renders a fixed
+ *  note sequence through NoteOn/Render for every preset, once with the
+ *  preset's own OSC2 setting and once per OSC2 waveform, and compares
+ *  against reference samples and levels with RMS and peak error
+ *  tolerances. With
+ *  KICK_NOTE_OFFSETS scripted cases additionally post notes with sample
+ *  offsets into fixed 128-frame Render() calls: inside the call, beyond its
+ *  end, and several at the same offset.
+ *
+ *  Usage:
+ *    golden record <manifest>               write the reference manifest
+ *    golden check <manifest> [rms] [peak]   compare against the manifest
+ *    golden self [rms] [peak]               one-voice block renderer against
+ *                                           the scalar reference voice
+ *                                           (reference.h)
+ *
+ *  The manifest is a text file with one line per case: the name, an
+ *  FNV-1a hash of the mono output and the RMS and peak level of every
+ *  k_segment_frames segment. Next to it, in a directory named like the
+ *  manifest without extension (golden/float.txt -> golden/float/), every
+ *  case has its samples as <case>.s16: every k_sample_step-th frame as
+ *  little-endian int16. Both are small enough to be committed.
+ *
+ *  A bit-identical output passes on the hash. Otherwise the difference
+ *  signal against the stored samples has to stay within the tolerances,
+ *  which sees polarity, phase and waveform changes, and every segment
+ *  level as well, which sees peaks between the stored samples. A level
+ *  can move by at most the RMS or peak of the difference signal in that
+ *  segment, so the same tolerances apply. The int16 quantization adds at
+ *  most 1.6e-5.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <cerrno>
+#include <string>
+#include <sys/stat.h>
+
+#include "unit.h"
+#include "synth.h"
+#include "reference.h"
+
+// Parameter-IDs wie Synth::k_param_* (setParameter)
+enum {
+  k_id_osc2_enabled = 16,
+  k_id_osc2_waveform = 17,
+  k_id_osc2_level = 19,
+};
+
+static constexpr uint8_t k_num_presets = 5;
+static constexpr size_t k_case_frames = 72000;  // 1.5 s
+static constexpr size_t k_segment_frames = 2400;  // 50 ms je Pegelwert im Manifest
+static constexpr size_t k_num_segments = k_case_frames / k_segment_frames;
+
+static constexpr size_t k_sample_step = 8;        // jeder 8. Frame als Referenzsample
+static constexpr size_t k_num_samples = k_case_frames / k_sample_step;
+
+static_assert(k_case_frames % k_segment_frames == 0, "ganze Segmente");
+static_assert(k_case_frames % k_sample_step == 0, "ganze Schritte");
+
+// Feste Notenfolge: Anschlag, Retrigger im Ausklang, Anschläge nach Stille
+struct NoteEvent {
+  size_t frame;
+  uint8_t note;
+  uint8_t velocity;
+};
+
+static const NoteEvent s_sequence[] = {
+  {0, 36, 127},
+  {7200, 40, 90},
+  {24000, 31, 60},
+  {48000, 48, 110},
+};
+
+// Wechselnde Blockgrößen, damit auch Teilblöcke und Blockgrenzen abgedeckt sind
+static const size_t s_block_pattern[] = {64, 37, 128, 1, 64, 100};
+
+// Skripte: Noten mit Offset, vor dem Render()-Aufruf call gesendet. Alle
+// Aufrufe rendern k_script_block Frames, die Noten teilen die Blöcke also
+// selbst
+static constexpr size_t k_script_block = 128;
+
+struct ScriptEvent {
+  size_t call;
+  bool note_on;
+  uint8_t note;
+  uint8_t velocity;
+  uint16_t offset;
+};
+
+struct Script {
+  const char * name;
+  const ScriptEvent * events;
+  size_t num_events;
+};
+
+// Offset innerhalb des Aufrufs, wie NoteOn(.., 37) vor Render(128)
+static const ScriptEvent s_script_offset[] = {
+  {0, true, 36, 127, 37},
+  {56, true, 40, 90, 37},
+  {187, true, 31, 60, 127},
+  {375, true, 48, 110, 1},
+};
+
+// Offsets jenseits des Aufrufs: im nächsten bzw. erst einige Aufrufe später
+static const ScriptEvent s_script_late[] = {
+  {0, true, 36, 127, 200},
+  {56, true, 40, 90, 128},
+  {187, true, 31, 60, 1000},
+  {187, false, 31, 0, 9000},
+};
+
+// Mehrere Ereignisse am selben Offset, in Aufrufreihenfolge
+static const ScriptEvent s_script_same[] = {
+  {0, true, 36, 127, 64},
+  {0, true, 43, 100, 64},
+  {0, false, 36, 0, 64},
+  {187, true, 48, 110, 100},
+  {187, false, 48, 0, 100},
+  {187, true, 48, 80, 100},
+};
+
+static const Script s_scripts[] = {
+  {"offset37", s_script_offset, sizeof(s_script_offset) / sizeof(s_script_offset[0])},
+  {"offset_late", s_script_late, sizeof(s_script_late) / sizeof(s_script_late[0])},
+  {"offset_same", s_script_same, sizeof(s_script_same) / sizeof(s_script_same[0])},
+};
+
+static constexpr size_t k_num_scripts = sizeof(s_scripts) / sizeof(s_scripts[0]);
+static const uint8_t s_script_presets[] = {0, 3};  // Basic, FM Kick
+
+struct Case {
+  uint8_t preset;
+  int8_t waveform;  // -1: OSC2 wie im Preset
+  int8_t script;    // -1: s_sequence mit geteilten Blöcken, sonst s_scripts[script]
+};
+
+static std::vector<Case> makeCases() {
+  std::vector<Case> cases;
+  for (uint8_t p = 0; p < k_num_presets; ++p) {
+    for (int8_t w = -1; w < k_num_waves; ++w) {
+      cases.push_back({p, w, -1});
+    }
+  }
+#ifdef KICK_NOTE_OFFSETS
+  for (uint8_t p : s_script_presets) {
+    for (int8_t sc = 0; sc < static_cast<int8_t>(k_num_scripts); ++sc) {
+      cases.push_back({p, -1, sc});
+    }
+  }
+#endif
+  return cases;
+}
+
+static void caseName(const Case & c, char * buf, size_t len) {
+  if (c.script >= 0) {
+    std::snprintf(buf, len, "preset%u_%s", c.preset, s_scripts[c.script].name);
+  } else if (c.waveform < 0) {
+    std::snprintf(buf, len, "preset%u_default", c.preset);
+  } else {
+    std::snprintf(buf, len, "preset%u_osc2_%s", c.preset, s_waveform_names[c.waveform]);
+  }
+  for (char * p = buf; *p; ++p) {
+    if (*p == ' ') *p = '_';
+  }
+}
+
+// Notenfolge ohne Offsets, die Blöcke werden an den Notenzeitpunkten
+// geteilt: note_on(note, velocity), dann render(pos, frames)
+template <typename NoteOn, typename Render>
+static void playSequence(NoteOn note_on, Render render) {
+  const size_t num_events = sizeof(s_sequence) / sizeof(s_sequence[0]);
+  const size_t num_blocks = sizeof(s_block_pattern) / sizeof(s_block_pattern[0]);
+  size_t event = 0;
+  size_t pos = 0;
+  for (size_t b = 0; pos < k_case_frames; ++b) {
+    size_t n = s_block_pattern[b % num_blocks];
+    if (event < num_events && s_sequence[event].frame == pos) {
+      note_on(s_sequence[event].note, s_sequence[event].velocity);
+      ++event;
+    }
+    // Blöcke an den Notenzeitpunkten teilen
+    if (event < num_events && pos + n > s_sequence[event].frame) n = s_sequence[event].frame - pos;
+    if (pos + n > k_case_frames) n = k_case_frames - pos;
+    render(pos, n);
+    pos += n;
+  }
+}
+
+static void renderSequence(Synth & synth, std::vector<float> & stereo) {
+  playSequence([&](uint8_t note, uint8_t velocity) { synth.NoteOn(note, velocity); },
+               [&](size_t pos, size_t n) { synth.Render(&stereo[pos * 2], n); });
+}
+
+#ifdef KICK_NOTE_OFFSETS
+// Skript mit festen Aufrufen, die Noten tragen ihre Offsets
+static void renderScript(Synth & synth, const Script & script, std::vector<float> & stereo) {
+  size_t event = 0;
+  for (size_t call = 0, pos = 0; pos < k_case_frames; ++call) {
+    for (; event < script.num_events && script.events[event].call == call; ++event) {
+      const ScriptEvent & e = script.events[event];
+      if (e.note_on) {
+        synth.NoteOn(e.note, e.velocity, e.offset);
+      } else {
+        synth.NoteOff(e.note, e.offset);
+      }
+    }
+    const size_t n = pos + k_script_block > k_case_frames ? k_case_frames - pos : k_script_block;
+    synth.Render(&stereo[pos * 2], n);
+    pos += n;
+  }
+}
+#endif
+
+static void setupCase(Synth & synth, const Case & c) {
+  synth.LoadPreset(c.preset);
+  if (c.waveform >= 0) {
+    synth.setParameter(k_id_osc2_enabled, 1);
+    synth.setParameter(k_id_osc2_waveform, c.waveform);
+    synth.setParameter(k_id_osc2_level, 80);
+  }
+  synth.Reset();
+}
+
+// Rendert einen Fall als Mono-Puffer (beide Kanäle sind identisch)
+static std::vector<float> renderCase(Synth & synth, const Case & c) {
+  setupCase(synth, c);
+
+  std::vector<float> stereo(k_case_frames * 2);
+  std::vector<float> mono(k_case_frames);
+#ifdef KICK_NOTE_OFFSETS
+  if (c.script >= 0) {
+    renderScript(synth, s_scripts[c.script], stereo);
+  } else {
+    renderSequence(synth, stereo);
+  }
+#else
+  renderSequence(synth, stereo);
+#endif
+  for (size_t i = 0; i < k_case_frames; ++i) {
+    mono[i] = stereo[i * 2];
+  }
+  return mono;
+}
+
+// Derselbe Fall mit einer Stimme durch RenderMono und durch die Referenz
+// (nur die Notenfolge, nicht die Skripte). Ein Frame ohne Stimme setzt
+// vorher die Glättung ans Ziel, die Referenz kennt keine Rampen
+static void renderSelf(Synth & synth, ReferenceVoice & reference, const Case & c, std::vector<float> & out,
+                       std::vector<float> & ref) {
+  setupCase(synth, c);
+  float settle;
+  synth.RenderMono(&settle, 1);
+  reference.Configure(synth);
+  reference.Reset();
+  out.assign(k_case_frames, 0.f);
+  ref.assign(k_case_frames, 0.f);
+  playSequence(
+      [&](uint8_t note, uint8_t velocity) {
+        synth.NoteOn(note, velocity);
+        reference.NoteOn(velocity);
+      },
+      [&](size_t pos, size_t n) {
+        synth.RenderMono(&out[pos], n);
+        reference.Render(&ref[pos], n);
+      });
+}
+
+/*===========================================================================*/
+/* Comparison. */
+/*===========================================================================*/
+
+struct Tolerance {
+  double rms;
+  double peak;
+};
+
+// true wenn innerhalb der Toleranzen; step: Frames je Sample für die Ausgabe
+static bool compare(const char * name, const std::vector<float> & ref, const std::vector<float> & out,
+                    const Tolerance & tol, size_t step = 1) {
+  double sum = 0.0;
+  double peak = 0.0;
+  size_t peak_at = 0;
+  for (size_t i = 0; i < ref.size(); ++i) {
+    const double d = std::fabs(static_cast<double>(out[i]) - ref[i]);
+    sum += d * d;
+    if (d > peak || d != d) {
+      peak = d;
+      peak_at = i;
+    }
+  }
+  const double rms = std::sqrt(sum / ref.size());
+  const bool ok = rms <= tol.rms && peak <= tol.peak;
+  std::printf("%-4s %-28s rms %.3e  peak %.3e at %zu\n", ok ? "ok" : "FAIL", name, rms, peak, peak_at * step);
+  return ok;
+}
+
+/*===========================================================================*/
+/* Manifest. */
+/*===========================================================================*/
+
+// Fingerabdruck eines Falls: Hash der Bits und Pegel je Segment
+struct Levels {
+  uint64_t hash;
+  double rms[k_num_segments];
+  double peak[k_num_segments];
+};
+
+static Levels measure(const std::vector<float> & mono) {
+  Levels levels;
+  levels.hash = 14695981039346656037ull;
+  const unsigned char * bytes = reinterpret_cast<const unsigned char *>(mono.data());
+  for (size_t i = 0; i < mono.size() * sizeof(float); ++i) {
+    levels.hash = (levels.hash ^ bytes[i]) * 1099511628211ull;
+  }
+  for (size_t s = 0; s < k_num_segments; ++s) {
+    double sum = 0.0;
+    double peak = 0.0;
+    for (size_t i = s * k_segment_frames; i < (s + 1) * k_segment_frames; ++i) {
+      const double x = mono[i];
+      sum += x * x;
+      if (std::fabs(x) > peak || x != x) peak = std::fabs(x);
+    }
+    levels.rms[s] = std::sqrt(sum / k_segment_frames);
+    levels.peak[s] = peak;
+  }
+  return levels;
+}
+
+// Jedes Segment innerhalb der Toleranzen
+static bool compareLevels(const char * name, const Levels & ref, const Levels & out, const Tolerance & tol) {
+  double rms = 0.0;
+  double peak = 0.0;
+  size_t worst = 0;
+  for (size_t s = 0; s < k_num_segments; ++s) {
+    const double d_rms = std::fabs(out.rms[s] - ref.rms[s]);
+    const double d_peak = std::fabs(out.peak[s] - ref.peak[s]);
+    if (d_rms > rms || d_rms != d_rms) {
+      rms = d_rms;
+      worst = s;
+    }
+    if (d_peak > peak || d_peak != d_peak) peak = d_peak;
+  }
+  const bool ok = rms <= tol.rms && peak <= tol.peak;
+  std::printf("%-4s %-28s levels rms %.3e  peak %.3e in segment %zu\n", ok ? "ok" : "FAIL", name, rms, peak,
+              worst);
+  return ok;
+}
+
+static void writeLevels(FILE * f, const char * name, const Levels & levels) {
+  std::fprintf(f, "%s %016llx", name, static_cast<unsigned long long>(levels.hash));
+  for (size_t s = 0; s < k_num_segments; ++s) {
+    std::fprintf(f, " %.9e %.9e", levels.rms[s], levels.peak[s]);
+  }
+  std::fprintf(f, "\n");
+}
+
+// Sucht die Zeile des Falls name im Manifest
+static bool readLevels(FILE * f, const char * name, Levels & levels) {
+  std::rewind(f);
+  char line_name[64];
+  unsigned long long hash;
+  while (std::fscanf(f, "%63s %llx", line_name, &hash) == 2) {
+    bool ok = true;
+    for (size_t s = 0; s < k_num_segments && ok; ++s) {
+      ok = std::fscanf(f, "%lf %lf", &levels.rms[s], &levels.peak[s]) == 2;
+    }
+    if (!ok) return false;
+    if (std::strcmp(line_name, name) == 0) {
+      levels.hash = hash;
+      return true;
+    }
+  }
+  return false;
+}
+
+/*===========================================================================*/
+/* Reference Samples. */
+/*===========================================================================*/
+
+// golden/float.txt -> golden/float
+static std::string sampleDir(const char * manifest) {
+  std::string dir(manifest);
+  const size_t dot = dir.rfind('.');
+  const size_t slash = dir.rfind('/');
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) dir.resize(dot);
+  return dir;
+}
+
+static std::string samplePath(const std::string & dir, const char * name) {
+  return dir + "/" + name + ".s16";
+}
+
+// Jeder k_sample_step-te Frame
+static std::vector<float> decimate(const std::vector<float> & mono) {
+  std::vector<float> samples(k_num_samples);
+  for (size_t i = 0; i < k_num_samples; ++i) {
+    samples[i] = mono[i * k_sample_step];
+  }
+  return samples;
+}
+
+static bool writeSamples(const std::string & path, const std::vector<float> & samples) {
+  FILE * f = std::fopen(path.c_str(), "wb");
+  if (!f) return false;
+  bool ok = true;
+  for (size_t i = 0; i < samples.size() && ok; ++i) {
+    float x = samples[i] * 32767.f;
+    x = x > 32767.f ? 32767.f : (x < -32767.f ? -32767.f : x);
+    const int16_t q = static_cast<int16_t>(std::lrint(x));
+    const unsigned char le[2] = {static_cast<unsigned char>(q & 0xff), static_cast<unsigned char>((q >> 8) & 0xff)};
+    ok = std::fwrite(le, 1, 2, f) == 2;
+  }
+  return std::fclose(f) == 0 && ok;
+}
+
+static bool readSamples(const std::string & path, std::vector<float> & samples) {
+  FILE * f = std::fopen(path.c_str(), "rb");
+  if (!f) return false;
+  samples.assign(k_num_samples, 0.f);
+  bool ok = true;
+  for (size_t i = 0; i < k_num_samples && ok; ++i) {
+    unsigned char le[2];
+    ok = std::fread(le, 1, 2, f) == 2;
+    const int16_t q = static_cast<int16_t>(le[0] | (le[1] << 8));
+    samples[i] = q * (1.f / 32767.f);
+  }
+  std::fclose(f);
+  return ok;
+}
+
+static int usage(const char * prog) {
+  std::fprintf(stderr,
+               "usage: %s record <manifest>\n"
+               "       %s check <manifest> [rms] [peak]\n"
+               "       %s self [rms] [peak]\n",
+               prog, prog, prog);
+  return 2;
+}
+
+int main(int argc, char ** argv) {
+  if (argc < 2) return usage(argv[0]);
+  const bool self = std::strcmp(argv[1], "self") == 0;
+  const bool record = std::strcmp(argv[1], "record") == 0;
+  const bool check = std::strcmp(argv[1], "check") == 0;
+  if (!self && !record && !check) return usage(argv[0]);
+  if (!self && argc < 3) return usage(argv[0]);
+
+#ifdef KICK_FIXED_POINT
+  // Die Referenz rechnet wie der Float-Kernel, der Fixpunkt-Kernel
+  // quantisiert absichtlich (siehe fixed.h)
+  if (self) {
+    std::fprintf(stderr, "self: the scalar reference models the float kernel only\n");
+    return 2;
+  }
+#endif
+
+  // Erlaubt nur Rundungsunterschiede (Compiler, NEON vs. Emulation). Gegen
+  // die skalare Referenz gemessen (Emulation): RMS < 3e-8, Spitze < 1.5e-6,
+  // aus Summationsreihenfolge und vmla; der Abstand deckt den geschätzten
+  // Reziprokwert (vrecpe mit Newton, simd.h) auf echtem NEON ab
+  const int tol_arg = self ? 2 : 3;
+  Tolerance tol = self ? Tolerance{1e-5, 1e-3} : Tolerance{1e-4, 1e-2};
+  if (argc > tol_arg) tol.rms = std::atof(argv[tol_arg]);
+  if (argc > tol_arg + 1) tol.peak = std::atof(argv[tol_arg + 1]);
+
+  FILE * manifest = nullptr;
+  std::string samples_dir;
+  if (!self) {
+    manifest = std::fopen(argv[2], record ? "w" : "r");
+    if (!manifest) {
+      std::fprintf(stderr, "cannot %s %s%s\n", record ? "write" : "read", argv[2],
+                   record ? "" : " (run 'record' first)");
+      return 2;
+    }
+    samples_dir = sampleDir(argv[2]);
+    if (record && mkdir(samples_dir.c_str(), 0777) != 0 && errno != EEXIST) {
+      std::fprintf(stderr, "cannot create %s\n", samples_dir.c_str());
+      std::fclose(manifest);
+      return 2;
+    }
+  }
+
+  static Synth synth;
+  static ReferenceVoice reference;
+  const std::vector<Case> cases = makeCases();
+  size_t failures = 0;
+  size_t compared = 0;
+  if (self) synth.setPolyphony(1);
+  for (size_t i = 0; i < cases.size(); ++i) {
+    char name[64];
+    caseName(cases[i], name, sizeof(name));
+    if (self) {
+      if (cases[i].script >= 0) continue;
+      std::vector<float> out;
+      std::vector<float> ref;
+      renderSelf(synth, reference, cases[i], out, ref);
+      ++compared;
+      if (!compare(name, ref, out, tol)) ++failures;
+      continue;
+    }
+    const std::vector<float> mono = renderCase(synth, cases[i]);
+    const Levels out = measure(mono);
+    const std::string path = samplePath(samples_dir, name);
+    ++compared;
+
+    if (record) {
+      writeLevels(manifest, name, out);
+      if (!writeSamples(path, decimate(mono))) {
+        std::fprintf(stderr, "cannot write %s\n", path.c_str());
+        std::fclose(manifest);
+        return 2;
+      }
+    } else {
+      Levels ref;
+      std::vector<float> ref_samples;
+      if (!readLevels(manifest, name, ref)) {
+        std::fprintf(stderr, "%s: no entry for %s (run 'record' first)\n", argv[2], name);
+        std::fclose(manifest);
+        return 2;
+      }
+      if (ref.hash == out.hash) {
+        std::printf("%-4s %-28s bit-identical\n", "ok", name);
+        continue;
+      }
+      if (!readSamples(path, ref_samples)) {
+        std::fprintf(stderr, "cannot read %s (run 'record' first)\n", path.c_str());
+        std::fclose(manifest);
+        return 2;
+      }
+      // Beide Prüfungen laufen, damit beide Zeilen erscheinen
+      const bool samples_ok = compare(name, ref_samples, decimate(mono), tol, k_sample_step);
+      const bool levels_ok = compareLevels(name, ref, out, tol);
+      if (!samples_ok || !levels_ok) ++failures;
+    }
+  }
+
+  if (manifest && std::fclose(manifest) != 0) {
+    std::fprintf(stderr, "cannot write %s\n", argv[2]);
+    return 2;
+  }
+  if (record) {
+    std::printf("wrote %zu cases to %s\n", compared, argv[2]);
+  } else {
+    std::printf("%zu of %zu cases failed\n", failures, compared);
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+/*
+ *  File: host/latency.cc
+ *
+ *  Startup and preset-switch latency. Measures, as median and worst case
+ *  over many repetitions: constructing a Synth, Init, unit load up to the
+ *  first rendered block, the first hit of a fresh instance, and switching
+ *  presets up to the first (silent) block and the first hit with the new
+ *  preset.
+ *  With a file argument the results are also written there as CSV lines
+ *  "metric,median_us,max_us", so they can be tracked across commits.
+ *
+ *  Usage: latency [repetitions] [csv file]
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <vector>
+
+#include "unit.h"
+#include "synth.h"
+
+static constexpr size_t k_block = 64;
+static constexpr uint8_t k_num_presets = 5;
+
+static inline uint64_t nowNs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+static unit_runtime_desc_t makeDesc() {
+  unit_runtime_desc_t desc;
+  std::memset(&desc, 0, sizeof(desc));
+  desc.target = UNIT_TARGET_PLATFORM;
+  desc.api = UNIT_API_VERSION;
+  desc.samplerate = 48000;
+  desc.frames_per_buffer = k_block;
+  desc.output_channels = 2;
+  return desc;
+}
+
+/*===========================================================================*/
+/* Metrics. */
+/*===========================================================================*/
+
+struct Metric {
+  const char * name;
+  std::vector<uint64_t> ns;
+};
+
+static void report(Metric & m, FILE * csv) {
+  std::sort(m.ns.begin(), m.ns.end());
+  const double median = m.ns[m.ns.size() / 2] * 1e-3;
+  const double worst = m.ns.back() * 1e-3;
+  std::printf("%-22s %12.2f %12.2f\n", m.name, median, worst);
+  if (csv) std::fprintf(csv, "%s,%.3f,%.3f\n", m.name, median, worst);
+}
+
+int main(int argc, char ** argv) {
+  const int reps = argc > 1 ? std::atoi(argv[1]) : 200;
+  if (reps <= 0) {
+    std::fprintf(stderr, "usage: %s [repetitions] [csv file]\n", argv[0]);
+    return 1;
+  }
+  FILE * csv = nullptr;
+  if (argc > 2) {
+    csv = std::fopen(argv[2], "w");
+    if (!csv) {
+      std::fprintf(stderr, "cannot write %s\n", argv[2]);
+      return 2;
+    }
+  }
+
+  // Synth ist auf Cache-Lines ausgerichtet, ein einfaches new garantiert
+  // das vor C++17 nicht
+  void * mem = nullptr;
+  if (posix_memalign(&mem, k_arena_base_align, sizeof(Synth)) != 0) return 2;
+  const unit_runtime_desc_t desc = makeDesc();
+  alignas(16) static float out[k_block * 2];
+
+  Metric construct = {"construct", {}};
+  Metric init = {"init", {}};
+  Metric first_block = {"load_to_first_block", {}};
+  Metric first_hit = {"first_hit_block", {}};
+  Metric preset = {"preset_switch_block", {}};
+  Metric preset_hit = {"preset_switch_hit", {}};
+
+  // Laden der Unit: Konstruktor, Init, erster Block; danach der erste Anschlag
+  for (int r = 0; r < reps; ++r) {
+    const uint64_t t0 = nowNs();
+    Synth * synth = new (mem) Synth();
+    const uint64_t t1 = nowNs();
+    synth->Init(&desc);
+    const uint64_t t2 = nowNs();
+    synth->Render(out, k_block);
+    const uint64_t t3 = nowNs();
+    synth->NoteOn(48, 100);
+    synth->Render(out, k_block);
+    const uint64_t t4 = nowNs();
+    construct.ns.push_back(t1 - t0);
+    init.ns.push_back(t2 - t1);
+    first_block.ns.push_back(t3 - t0);
+    first_hit.ns.push_back(t4 - t3);
+    synth->~Synth();
+  }
+
+  // Presetwechsel bis zum ersten Block mit dem neuen Preset, alle Paare
+  Synth * synth = new (mem) Synth();
+  synth->Init(&desc);
+  synth->Render(out, k_block);
+  for (int r = 0; r < reps; ++r) {
+    for (uint8_t p = 0; p < k_num_presets; ++p) {
+      const uint64_t t0 = nowNs();
+      synth->LoadPreset(p);
+      synth->Render(out, k_block);
+      const uint64_t t1 = nowNs();
+      synth->NoteOn(48, 100);
+      synth->Render(out, k_block);
+      const uint64_t t2 = nowNs();
+      preset.ns.push_back(t1 - t0);
+      preset_hit.ns.push_back(t2 - t1);
+      synth->Reset();  // Stimmen aus, der nächste Wechsel startet ohne Ausklang
+    }
+  }
+  synth->~Synth();
+  std::free(mem);
+
+#ifdef KICK_NEON_EMULATED
+  std::printf("# NEON: scalar emulation (timings are not representative of the target)\n");
+#endif
+  std::printf("# %d repetitions, block %zu\n", reps, k_block);
+  std::printf("%-22s %12s %12s\n", "metric", "median us", "max us");
+  report(construct, csv);
+  report(init, csv);
+  report(first_block, csv);
+  report(first_hit, csv);
+  report(preset, csv);
+  report(preset_hit, csv);
+  if (csv) std::fclose(csv);
+  return 0;
+}
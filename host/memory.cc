@@ -0,0 +1,30 @@
+/*
+ *  File: host/memory.cc
+ *
+ *  Memory budget report. Lists the bytes each subsystem takes from the
+ *  synth's static arena and the size of the Synth object against
+ *  k_memory_budget. Runs as part of the host build.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstdio>
+
+#include "unit.h"
+#include "synth.h"
+
+int main() {
+  size_t total = 0;
+  std::printf("%-16s %10s\n", "subsystem", "bytes");
+  for (uint8_t region = 0; region < Synth::k_num_mem_regions; ++region) {
+    const size_t bytes = Synth::getMemoryUsage(region);
+    std::printf("%-16s %10zu\n", Synth::getMemoryRegionName(region), bytes);
+    total += bytes;
+  }
+  std::printf("%-16s %10zu\n", "arena total", total);
+  std::printf("%-16s %10zu\n", "sizeof(Synth)", sizeof(Synth));
+  std::printf("%-16s %10zu  (%.1f%% used)\n", "budget", Synth::getMemoryBudget(),
+              100.0 * sizeof(Synth) / Synth::getMemoryBudget());
+  return 0;
+}
@@ -0,0 +1,281 @@
+#pragma once
+/*
+ *  File: host/neon/arm_neon.h
+ *
+ *  Scalar stand-in for the subset of ARMv7 NEON intrinsics used by the
+ *  synth, so the DSP code builds and runs unchanged on x86 hosts. Only
+ *  put on the include path when the host compiler has no NEON support.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#define KICK_NEON_EMULATED 1
+
+#define NEON_EMU_VEC(name, type, n) \
+  typedef struct { type v[n]; } name;
+
+NEON_EMU_VEC(float32x2_t, float, 2)
+NEON_EMU_VEC(float32x4_t, float, 4)
+NEON_EMU_VEC(uint32x2_t, uint32_t, 2)
+NEON_EMU_VEC(uint32x4_t, uint32_t, 4)
+NEON_EMU_VEC(int32x2_t, int32_t, 2)
+NEON_EMU_VEC(int32x4_t, int32_t, 4)
+NEON_EMU_VEC(int16x4_t, int16_t, 4)
+NEON_EMU_VEC(int16x8_t, int16_t, 8)
+NEON_EMU_VEC(uint16x4_t, uint16_t, 4)
+NEON_EMU_VEC(int64x2_t, int64_t, 2)
+
+typedef struct { float32x4_t val[2]; } float32x4x2_t;
+typedef struct { float32x4_t val[4]; } float32x4x4_t;
+typedef struct { float32x2_t val[2]; } float32x2x2_t;
+typedef struct { int32x4_t val[4]; } int32x4x4_t;
+
+#define NEON_EMU_MAP1(res, a, expr) \
+  { res r; for (unsigned i = 0; i < sizeof(r.v) / sizeof(r.v[0]); ++i) { r.v[i] = (expr); } return r; }
+
+/* ---- Load / store ---------------------------------------------------------------------------- */
+
+static inline float32x4_t vld1q_f32(const float * p) { float32x4_t r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline float32x2_t vld1_f32(const float * p) { float32x2_t r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline uint32x4_t vld1q_u32(const uint32_t * p) { uint32x4_t r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline int32x4_t vld1q_s32(const int32_t * p) { int32x4_t r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline int16x4_t vld1_s16(const int16_t * p) { int16x4_t r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline float32x4_t vld1q_dup_f32(const float * p) { float32x4_t r; for (int i = 0; i < 4; ++i) r.v[i] = *p; return r; }
+static inline void vst1q_f32(float * p, float32x4_t a) { std::memcpy(p, a.v, sizeof(a.v)); }
+static inline void vst1_f32(float * p, float32x2_t a) { std::memcpy(p, a.v, sizeof(a.v)); }
+static inline void vst1q_u32(uint32_t * p, uint32x4_t a) { std::memcpy(p, a.v, sizeof(a.v)); }
+static inline void vst1q_s32(int32_t * p, int32x4_t a) { std::memcpy(p, a.v, sizeof(a.v)); }
+static inline void vst1_s16(int16_t * p, int16x4_t a) { std::memcpy(p, a.v, sizeof(a.v)); }
+
+static inline void vst2q_f32(float * p, float32x4x2_t a) {
+  for (int i = 0; i < 4; ++i) { p[2 * i] = a.val[0].v[i]; p[2 * i + 1] = a.val[1].v[i]; }
+}
+static inline float32x4x2_t vld2q_f32(const float * p) {
+  float32x4x2_t r;
+  for (int i = 0; i < 4; ++i) { r.val[0].v[i] = p[2 * i]; r.val[1].v[i] = p[2 * i + 1]; }
+  return r;
+}
+static inline void vst4q_f32(float * p, float32x4x4_t a) {
+  for (int i = 0; i < 4; ++i) for (int k = 0; k < 4; ++k) p[4 * i + k] = a.val[k].v[i];
+}
+static inline float32x4x4_t vld4q_f32(const float * p) {
+  float32x4x4_t r;
+  for (int i = 0; i < 4; ++i) for (int k = 0; k < 4; ++k) r.val[k].v[i] = p[4 * i + k];
+  return r;
+}
+static inline int32x4x4_t vld4q_s32(const int32_t * p) {
+  int32x4x4_t r;
+  for (int i = 0; i < 4; ++i) for (int k = 0; k < 4; ++k) r.val[k].v[i] = p[4 * i + k];
+  return r;
+}
+
+#define vld1q_lane_f32(p, a, lane) (__extension__({ float32x4_t _r = (a); _r.v[(lane)] = *(p); _r; }))
+#define vst1q_lane_f32(p, a, lane) (*(p) = (a).v[(lane)])
+
+/* ---- Construction / lanes -------------------------------------------------------------------- */
+
+static inline float32x4_t vdupq_n_f32(float x) { float32x4_t r; for (int i = 0; i < 4; ++i) r.v[i] = x; return r; }
+static inline float32x2_t vdup_n_f32(float x) { float32x2_t r; r.v[0] = r.v[1] = x; return r; }
+static inline uint32x4_t vdupq_n_u32(uint32_t x) { uint32x4_t r; for (int i = 0; i < 4; ++i) r.v[i] = x; return r; }
+static inline int32x4_t vdupq_n_s32(int32_t x) { int32x4_t r; for (int i = 0; i < 4; ++i) r.v[i] = x; return r; }
+#define vmovq_n_f32 vdupq_n_f32
+#define vmovq_n_u32 vdupq_n_u32
+#define vmovq_n_s32 vdupq_n_s32
+
+#define vgetq_lane_f32(a, lane) ((a).v[(lane)])
+#define vgetq_lane_u32(a, lane) ((a).v[(lane)])
+#define vgetq_lane_s32(a, lane) ((a).v[(lane)])
+#define vget_lane_f32(a, lane) ((a).v[(lane)])
+#define vsetq_lane_f32(x, a, lane) (__extension__({ float32x4_t _r = (a); _r.v[(lane)] = (x); _r; }))
+#define vsetq_lane_u32(x, a, lane) (__extension__({ uint32x4_t _r = (a); _r.v[(lane)] = (x); _r; }))
+#define vsetq_lane_s32(x, a, lane) (__extension__({ int32x4_t _r = (a); _r.v[(lane)] = (x); _r; }))
+#define vdupq_lane_f32(a, lane) vdupq_n_f32((a).v[(lane)])
+
+static inline float32x2_t vget_low_f32(float32x4_t a) { float32x2_t r; r.v[0] = a.v[0]; r.v[1] = a.v[1]; return r; }
+static inline float32x2_t vget_high_f32(float32x4_t a) { float32x2_t r; r.v[0] = a.v[2]; r.v[1] = a.v[3]; return r; }
+static inline float32x4_t vcombine_f32(float32x2_t a, float32x2_t b) {
+  float32x4_t r; r.v[0] = a.v[0]; r.v[1] = a.v[1]; r.v[2] = b.v[0]; r.v[3] = b.v[1]; return r;
+}
+static inline int16x8_t vcombine_s16(int16x4_t a, int16x4_t b) {
+  int16x8_t r; for (int i = 0; i < 4; ++i) { r.v[i] = a.v[i]; r.v[i + 4] = b.v[i]; } return r;
+}
+
+#define vextq_f32(a, b, n) (__extension__({ \
+  float32x4_t _a = (a), _b = (b), _r; \
+  for (int _i = 0; _i < 4; ++_i) _r.v[_i] = (_i + (n) < 4) ? _a.v[_i + (n)] : _b.v[_i + (n) - 4]; \
+  _r; }))
+#define vextq_s32(a, b, n) (__extension__({ \
+  int32x4_t _a = (a), _b = (b), _r; \
+  for (int _i = 0; _i < 4; ++_i) _r.v[_i] = (_i + (n) < 4) ? _a.v[_i + (n)] : _b.v[_i + (n) - 4]; \
+  _r; }))
+#define vextq_u32(a, b, n) (__extension__({ \
+  uint32x4_t _a = (a), _b = (b), _r; \
+  for (int _i = 0; _i < 4; ++_i) _r.v[_i] = (_i + (n) < 4) ? _a.v[_i + (n)] : _b.v[_i + (n) - 4]; \
+  _r; }))
+
+static inline float32x4_t vrev64q_f32(float32x4_t a) {
+  float32x4_t r; r.v[0] = a.v[1]; r.v[1] = a.v[0]; r.v[2] = a.v[3]; r.v[3] = a.v[2]; return r;
+}
+
+/* ---- Float arithmetic ------------------------------------------------------------------------ */
+
+static inline float32x4_t vaddq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(float32x4_t, a, a.v[i] + b.v[i])
+static inline float32x4_t vsubq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(float32x4_t, a, a.v[i] - b.v[i])
+static inline float32x4_t vmulq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(float32x4_t, a, a.v[i] * b.v[i])
+static inline float32x4_t vmulq_n_f32(float32x4_t a, float b) NEON_EMU_MAP1(float32x4_t, a, a.v[i] * b)
+static inline float32x4_t vmlaq_f32(float32x4_t a, float32x4_t b, float32x4_t c) NEON_EMU_MAP1(float32x4_t, a, a.v[i] + b.v[i] * c.v[i])
+static inline float32x4_t vmlsq_f32(float32x4_t a, float32x4_t b, float32x4_t c) NEON_EMU_MAP1(float32x4_t, a, a.v[i] - b.v[i] * c.v[i])
+static inline float32x4_t vmlaq_n_f32(float32x4_t a, float32x4_t b, float c) NEON_EMU_MAP1(float32x4_t, a, a.v[i] + b.v[i] * c)
+static inline float32x4_t vmlsq_n_f32(float32x4_t a, float32x4_t b, float c) NEON_EMU_MAP1(float32x4_t, a, a.v[i] - b.v[i] * c)
+static inline float32x4_t vfmaq_f32(float32x4_t a, float32x4_t b, float32x4_t c) NEON_EMU_MAP1(float32x4_t, a, std::fma(b.v[i], c.v[i], a.v[i]))
+static inline float32x4_t vabsq_f32(float32x4_t a) NEON_EMU_MAP1(float32x4_t, a, std::fabs(a.v[i]))
+static inline float32x4_t vnegq_f32(float32x4_t a) NEON_EMU_MAP1(float32x4_t, a, -a.v[i])
+static inline float32x4_t vminq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(float32x4_t, a, a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+static inline float32x4_t vmaxq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(float32x4_t, a, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+static inline float32x2_t vadd_f32(float32x2_t a, float32x2_t b) NEON_EMU_MAP1(float32x2_t, a, a.v[i] + b.v[i])
+static inline float32x2_t vmul_f32(float32x2_t a, float32x2_t b) NEON_EMU_MAP1(float32x2_t, a, a.v[i] * b.v[i])
+static inline float32x2_t vmax_f32(float32x2_t a, float32x2_t b) NEON_EMU_MAP1(float32x2_t, a, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+static inline float32x2_t vpadd_f32(float32x2_t a, float32x2_t b) {
+  float32x2_t r; r.v[0] = a.v[0] + a.v[1]; r.v[1] = b.v[0] + b.v[1]; return r;
+}
+static inline float32x2_t vpmax_f32(float32x2_t a, float32x2_t b) {
+  float32x2_t r;
+  r.v[0] = a.v[0] > a.v[1] ? a.v[0] : a.v[1];
+  r.v[1] = b.v[0] > b.v[1] ? b.v[0] : b.v[1];
+  return r;
+}
+
+// Schätzwerte wie auf der Hardware nur auf ~8 Bit genau, damit Newton-Schritte greifen
+static inline float neon_emu_trunc8(float x) {
+  int e;
+  const float m = std::frexp(x, &e);
+  return std::ldexp(std::floor(m * 256.f) / 256.f, e);
+}
+static inline float32x4_t vrecpeq_f32(float32x4_t a) NEON_EMU_MAP1(float32x4_t, a, neon_emu_trunc8(1.f / a.v[i]))
+static inline float32x4_t vrecpsq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(float32x4_t, a, 2.f - a.v[i] * b.v[i])
+static inline float32x4_t vrsqrteq_f32(float32x4_t a) NEON_EMU_MAP1(float32x4_t, a, neon_emu_trunc8(1.f / std::sqrt(a.v[i])))
+static inline float32x4_t vrsqrtsq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(float32x4_t, a, (3.f - a.v[i] * b.v[i]) * 0.5f)
+
+/* ---- Comparisons / select -------------------------------------------------------------------- */
+
+static inline uint32x4_t vcltq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] < b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcleq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] <= b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcgtq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] > b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcgeq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] >= b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vceqq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] == b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcagtq_f32(float32x4_t a, float32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, std::fabs(a.v[i]) > std::fabs(b.v[i]) ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcltq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] < b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcgtq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] > b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcgeq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] >= b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcltq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] < b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcgeq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] >= b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vcgtq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] > b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline uint32x4_t vceqq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] == b.v[i] ? 0xFFFFFFFFu : 0u)
+
+static inline float32x4_t vbslq_f32(uint32x4_t m, float32x4_t a, float32x4_t b) {
+  float32x4_t r;
+  for (int i = 0; i < 4; ++i) {
+    uint32_t ua, ub;
+    std::memcpy(&ua, &a.v[i], 4);
+    std::memcpy(&ub, &b.v[i], 4);
+    const uint32_t u = (ua & m.v[i]) | (ub & ~m.v[i]);
+    std::memcpy(&r.v[i], &u, 4);
+  }
+  return r;
+}
+static inline uint32x4_t vbslq_u32(uint32x4_t m, uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, (a.v[i] & m.v[i]) | (b.v[i] & ~m.v[i]))
+static inline int32x4_t vbslq_s32(uint32x4_t m, int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, (int32_t)(((uint32_t)a.v[i] & m.v[i]) | ((uint32_t)b.v[i] & ~m.v[i])))
+
+/* ---- Integer arithmetic / logic -------------------------------------------------------------- */
+
+static inline uint32x4_t vaddq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] + b.v[i])
+static inline uint32x4_t vsubq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] - b.v[i])
+static inline uint32x4_t vmulq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] * b.v[i])
+static inline uint32x4_t vmlaq_u32(uint32x4_t a, uint32x4_t b, uint32x4_t c) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] + b.v[i] * c.v[i])
+static inline uint32x4_t vandq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] & b.v[i])
+static inline uint32x4_t vorrq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] | b.v[i])
+static inline uint32x4_t veorq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] ^ b.v[i])
+static inline uint32x4_t vmvnq_u32(uint32x4_t a) NEON_EMU_MAP1(uint32x4_t, a, ~a.v[i])
+static inline uint32x4_t vmaxq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+static inline uint32x4_t vminq_u32(uint32x4_t a, uint32x4_t b) NEON_EMU_MAP1(uint32x4_t, a, a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+#define vshrq_n_u32(a, n) (__extension__({ uint32x4_t _a = (a), _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = _a.v[_i] >> (n); _r; }))
+#define vshlq_n_u32(a, n) (__extension__({ uint32x4_t _a = (a), _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = _a.v[_i] << (n); _r; }))
+
+static inline int32x4_t vaddq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, (int32_t)((uint32_t)a.v[i] + (uint32_t)b.v[i]))
+static inline int32x4_t vsubq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, (int32_t)((uint32_t)a.v[i] - (uint32_t)b.v[i]))
+static inline int32x4_t vmulq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, (int32_t)((uint32_t)a.v[i] * (uint32_t)b.v[i]))
+static inline int32x4_t vandq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, a.v[i] & b.v[i])
+static inline int32x4_t veorq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, a.v[i] ^ b.v[i])
+static inline int32x4_t vminq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+static inline int32x4_t vmaxq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+static inline int32x4_t vabsq_s32(int32x4_t a) NEON_EMU_MAP1(int32x4_t, a, a.v[i] < 0 ? -a.v[i] : a.v[i])
+static inline int32x4_t vnegq_s32(int32x4_t a) NEON_EMU_MAP1(int32x4_t, a, (int32_t)(0u - (uint32_t)a.v[i]))
+#define vshrq_n_s32(a, n) (__extension__({ int32x4_t _a = (a), _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = _a.v[_i] >> (n); _r; }))
+#define vshlq_n_s32(a, n) (__extension__({ int32x4_t _a = (a), _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = (int32_t)((uint32_t)_a.v[_i] << (n)); _r; }))
+#define vrshrq_n_s32(a, n) (__extension__({ int32x4_t _a = (a), _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = (int32_t)(((int64_t)_a.v[_i] + (1LL << ((n) - 1))) >> (n)); _r; }))
+
+static inline int32_t neon_emu_sat32(int64_t x) {
+  return x > INT32_MAX ? INT32_MAX : (x < INT32_MIN ? INT32_MIN : (int32_t)x);
+}
+static inline int16_t neon_emu_sat16(int32_t x) {
+  return x > INT16_MAX ? INT16_MAX : (x < INT16_MIN ? INT16_MIN : (int16_t)x);
+}
+static inline int32x4_t vqaddq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, neon_emu_sat32((int64_t)a.v[i] + b.v[i]))
+static inline int32x4_t vqsubq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, neon_emu_sat32((int64_t)a.v[i] - b.v[i]))
+static inline int32x4_t vqdmulhq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, neon_emu_sat32(((int64_t)a.v[i] * b.v[i] * 2) >> 32))
+static inline int32x4_t vqrdmulhq_s32(int32x4_t a, int32x4_t b) NEON_EMU_MAP1(int32x4_t, a, neon_emu_sat32(((int64_t)a.v[i] * b.v[i] * 2 + (1LL << 31)) >> 32))
+static inline int32x4_t vqdmulhq_n_s32(int32x4_t a, int32_t b) NEON_EMU_MAP1(int32x4_t, a, neon_emu_sat32(((int64_t)a.v[i] * b * 2) >> 32))
+static inline int32x4_t vqrdmulhq_n_s32(int32x4_t a, int32_t b) NEON_EMU_MAP1(int32x4_t, a, neon_emu_sat32(((int64_t)a.v[i] * b * 2 + (1LL << 31)) >> 32))
+static inline int32x4_t vqabsq_s32(int32x4_t a) NEON_EMU_MAP1(int32x4_t, a, a.v[i] == INT32_MIN ? INT32_MAX : (a.v[i] < 0 ? -a.v[i] : a.v[i]))
+static inline int32x4_t vqnegq_s32(int32x4_t a) NEON_EMU_MAP1(int32x4_t, a, a.v[i] == INT32_MIN ? INT32_MAX : -a.v[i])
+#define vqshlq_n_s32(a, n) (__extension__({ int32x4_t _a = (a), _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = neon_emu_sat32((int64_t)_a.v[_i] << (n)); _r; }))
+static inline int16x4_t vqmovn_s32(int32x4_t a) NEON_EMU_MAP1(int16x4_t, a, neon_emu_sat16(a.v[i]))
+#define vqrshrn_n_s32(a, n) (__extension__({ int32x4_t _a = (a); int16x4_t _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = neon_emu_sat16((int32_t)neon_emu_sat32(((int64_t)_a.v[_i] + (1LL << ((n) - 1))) >> (n))); _r; }))
+static inline int32x4_t vmovl_s16(int16x4_t a) NEON_EMU_MAP1(int32x4_t, a, (int32_t)a.v[i])
+
+/* ---- Conversions / reinterpretation ---------------------------------------------------------- */
+
+static inline float32x4_t vcvtq_f32_s32(int32x4_t a) NEON_EMU_MAP1(float32x4_t, a, (float)a.v[i])
+static inline float32x4_t vcvtq_f32_u32(uint32x4_t a) NEON_EMU_MAP1(float32x4_t, a, (float)a.v[i])
+static inline int32_t neon_emu_cvt_s32(float x) {
+  if (!(x == x)) return 0;
+  if (x >= 2147483647.f) return INT32_MAX;
+  if (x <= -2147483648.f) return INT32_MIN;
+  return (int32_t)x;
+}
+static inline uint32_t neon_emu_cvt_u32(float x) {
+  if (!(x > 0.f)) return 0;
+  if (x >= 4294967295.f) return UINT32_MAX;
+  return (uint32_t)x;
+}
+static inline int32x4_t vcvtq_s32_f32(float32x4_t a) NEON_EMU_MAP1(int32x4_t, a, neon_emu_cvt_s32(a.v[i]))
+static inline uint32x4_t vcvtq_u32_f32(float32x4_t a) NEON_EMU_MAP1(uint32x4_t, a, neon_emu_cvt_u32(a.v[i]))
+#define vcvtq_n_f32_s32(a, n) (__extension__({ int32x4_t _a = (a); float32x4_t _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = std::ldexp((float)_a.v[_i], -(n)); _r; }))
+#define vcvtq_n_s32_f32(a, n) (__extension__({ float32x4_t _a = (a); int32x4_t _r; for (int _i = 0; _i < 4; ++_i) _r.v[_i] = neon_emu_cvt_s32(std::ldexp(_a.v[_i], (n))); _r; }))
+
+#define NEON_EMU_REINTERPRET(to, from, name) \
+  static inline to name(from a) { to r; static_assert(sizeof(r) == sizeof(a), "size"); std::memcpy(&r, &a, sizeof(r)); return r; }
+NEON_EMU_REINTERPRET(float32x4_t, uint32x4_t, vreinterpretq_f32_u32)
+NEON_EMU_REINTERPRET(uint32x4_t, float32x4_t, vreinterpretq_u32_f32)
+NEON_EMU_REINTERPRET(float32x4_t, int32x4_t, vreinterpretq_f32_s32)
+NEON_EMU_REINTERPRET(int32x4_t, float32x4_t, vreinterpretq_s32_f32)
+NEON_EMU_REINTERPRET(int32x4_t, uint32x4_t, vreinterpretq_s32_u32)
+NEON_EMU_REINTERPRET(uint32x4_t, int32x4_t, vreinterpretq_u32_s32)
+
+static inline float32x4x2_t vuzpq_f32(float32x4_t a, float32x4_t b) {
+  float32x4x2_t r;
+  r.val[0].v[0] = a.v[0]; r.val[0].v[1] = a.v[2]; r.val[0].v[2] = b.v[0]; r.val[0].v[3] = b.v[2];
+  r.val[1].v[0] = a.v[1]; r.val[1].v[1] = a.v[3]; r.val[1].v[2] = b.v[1]; r.val[1].v[3] = b.v[3];
+  return r;
+}
+static inline float32x4x2_t vzipq_f32(float32x4_t a, float32x4_t b) {
+  float32x4x2_t r;
+  r.val[0].v[0] = a.v[0]; r.val[0].v[1] = b.v[0]; r.val[0].v[2] = a.v[1]; r.val[0].v[3] = b.v[1];
+  r.val[1].v[0] = a.v[2]; r.val[1].v[1] = b.v[2]; r.val[1].v[2] = a.v[3]; r.val[1].v[3] = b.v[3];
+  return r;
+}
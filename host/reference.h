@@ -0,0 +1,416 @@
+#pragma once
+/*
+ *  File: host/reference.h
+ *
+ *  Scalar per-sample reference for the block renderer in the mono case
+ *  (Synth::setPolyphony(1)). One voice, one frame at a time, plain floats:
+ *  no block buffers, coefficient ramps, specialized kernels or lane layout.
+ *  It shares only the DSP primitives with the synth (sine tiers, envelope
+ *  segments, filter table, saturator, half-band coefficients, noise LCG)
+ *  and recomputes the signal chain of Synth::renderBlock() from them.
+ *
+ *  Parameters are taken as settled, i.e. the caller must render from a
+ *  state without running ramps. LFO, freeze and stereo spread are not
+ *  modelled. Like Render(), the voice runs in chunks of at most
+ *  k_block_size frames and a chunk that starts with the voice off stays
+ *  silent, so phases and noise advance exactly as in the block renderer.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "unit.h"
+#include "synth.h"
+
+// Parameter-IDs wie Synth::k_param_* (getParameterValue)
+enum {
+  k_ref_pitch = 0,
+  k_ref_decay,
+  k_ref_body_level,
+  k_ref_drive,
+  k_ref_attack,
+  k_ref_release,
+  k_ref_pitch_curve,
+  k_ref_lfo,
+  k_ref_click_level,
+  k_ref_click_freq,
+  k_ref_click_decay,
+  k_ref_click_tone,
+  k_ref_filter_enabled,
+  k_ref_filter_cutoff,
+  k_ref_filter_resonance,
+  k_ref_filter_mode,
+  k_ref_osc2_enabled,
+  k_ref_osc2_waveform,
+  k_ref_osc2_pitch,
+  k_ref_osc2_level,
+  k_ref_fm_amount,
+  k_ref_fm_ratio,
+  k_ref_osc2_decay,
+  k_ref_num_params = 24
+};
+
+/*===========================================================================*/
+/* Scalar Primitives. */
+/*===========================================================================*/
+
+inline float refFrac(float x) {
+  return x - std::floor(x);
+}
+
+// Wie vpolyblep_f32 (osc.h)
+inline float refPolyBlep(float t, float dt) {
+  if (t < dt) {
+    const float a = t / dt - 1.f;
+    return -a * a;
+  }
+  if (t > 1.f - dt) {
+    const float b = (t - 1.f) / dt + 1.f;
+    return b * b;
+  }
+  return 0.f;
+}
+
+// Wie vpolyblamp_f32 (osc.h)
+inline float refPolyBlamp(float t, float dt) {
+  if (t < dt) {
+    const float a = t / dt - 1.f;
+    return -a * a * a / 3.f;
+  }
+  if (t > 1.f - dt) {
+    const float b = (t - 1.f) / dt + 1.f;
+    return b * b * b / 3.f;
+  }
+  return 0.f;
+}
+
+// 2x-Interpolator wie HalfbandUp4, eine Eingabe pro Aufruf
+template <size_t kPairs>
+class RefHalfbandUp {
+public:
+  RefHalfbandUp(const float * coeffs) : coeffs_(coeffs) {
+    Reset();
+  }
+
+  inline void Reset() {
+    std::memset(hist_, 0, sizeof(hist_));
+  }
+
+  // out[0] FIR-Phase, out[1] um kPairs - 1 verzögerte Eingabe
+  inline void Process(float in, float * out) {
+    std::memmove(hist_ + 1, hist_, (k_len - 1) * sizeof(float));
+    hist_[0] = in;  // hist_[k] = Eingabe n - k
+    float even = 0.f;
+    for (size_t i = 0; i < kPairs; ++i) {
+      even += (hist_[kPairs - 1 - i] + hist_[kPairs + i]) * (2.f * coeffs_[i]);
+    }
+    out[0] = even;
+    out[1] = hist_[kPairs - 1];
+  }
+
+private:
+  static constexpr size_t k_len = 2 * kPairs;
+  const float * coeffs_;
+  float hist_[k_len];
+};
+
+// 2x-Dezimierer wie HalfbandDown4, zwei Eingaben pro Aufruf
+template <size_t kPairs>
+class RefHalfbandDown {
+public:
+  RefHalfbandDown(const float * coeffs) : coeffs_(coeffs) {
+    Reset();
+  }
+
+  inline void Reset() {
+    std::memset(hist_, 0, sizeof(hist_));
+  }
+
+  inline float Process(const float * in) {
+    std::memmove(hist_ + 2, hist_, (k_len - 2) * sizeof(float));
+    hist_[1] = in[0];
+    hist_[0] = in[1];  // hist_[k] = Eingabe 2m + 1 - k, Mitte bei k = 2 kPairs
+    float acc = hist_[2 * kPairs] * 0.5f;
+    for (size_t i = 0; i < kPairs; ++i) {
+      acc += (hist_[2 * kPairs - 1 - 2 * i] + hist_[2 * kPairs + 1 + 2 * i]) * coeffs_[i];
+    }
+    return acc;
+  }
+
+private:
+  static constexpr size_t k_len = 4 * kPairs;
+  const float * coeffs_;
+  float hist_[k_len];
+};
+
+/*===========================================================================*/
+/* Reference Voice. */
+/*===========================================================================*/
+
+class ReferenceVoice {
+public:
+  ReferenceVoice(void)
+      : up1_(k_hb_2x_c), up2_(k_hb_4x_c), down2_(k_hb_4x_c), down1_(k_hb_2x_c) {
+    std::memset(raw_, 0, sizeof(raw_));
+    tier_ = k_sine_poly7;
+    os_factor_ = k_os_1x;
+    derive();
+    Reset();
+  }
+
+  // Übernimmt die UI-Werte von synth (Parameter, Sinus-Kernel, Oversampling)
+  void Configure(const Synth & synth) {
+    for (uint8_t id = 0; id < k_ref_num_params; ++id) {
+      raw_[id] = synth.getParameterValue(id);
+    }
+    tier_ = synth.getSineTier();
+    os_factor_ = synth.getOversampling();
+    derive();
+  }
+
+  // Wie Synth::Reset(seed) für eine Stimme
+  void Reset(uint32_t seed = k_noise_default_seed) {
+    state_ = k_ref_state_off;
+    env_ = pitch_env_ = osc2_env_ = 0.f;
+    phase1_ = phase2_ = 0.f;
+    velocity_ = 0.f;
+    std::memset(filter_, 0, sizeof(filter_));
+    osc2_noise_.Seed(seed);
+    click_seed_ = seed ^ 0x9E3779B9u;
+    click_pos_ = click_length_ = 0;
+    up1_.Reset();
+    up2_.Reset();
+    down2_.Reset();
+    down1_.Reset();
+  }
+
+  // Anschlag am Anfang des nächsten Render(); Phasen und Oversampling
+  // laufen weiter wie beim Retrigger einer Stimme im Pool
+  void NoteOn(uint8_t velocity) {
+    velocity_ = velocity / 127.f;
+    state_ = k_ref_state_attack;
+    env_ = 0.f;
+    pitch_env_ = osc2_env_ = 1.f;
+    std::memset(filter_, 0, sizeof(filter_));
+    click_pos_ = 0;
+    click_length_ = clickLength();
+    click_noise_.Seed(click_seed_);
+    click_prev_ = 0.f;
+    click_env_ = envStep(click_seg_, 1.f, 1);
+  }
+
+  // Mono, in Stücken wie Render(): ein Stück, das ohne Stimme beginnt, bleibt still
+  void Render(float * out, size_t frames) {
+    for (size_t pos = 0; pos < frames;) {
+      const size_t n = frames - pos < k_block_size ? frames - pos : k_block_size;
+      if (state_ == k_ref_state_off) {
+        std::memset(out + pos, 0, n * sizeof(float));
+      } else {
+        for (size_t i = 0; i < n; ++i) out[pos + i] = process();
+      }
+      pos += n;
+    }
+  }
+
+private:
+  enum {
+    k_ref_state_off = 0,
+    k_ref_state_attack,
+    k_ref_state_falling  // Decay und Release
+  };
+
+  // Parameter-Einheiten -> Klangwerte wie Synth::applyParameter(), dann
+  // die Koeffizienten wie deriveEnvelopes()/deriveCoefficients()
+  void derive() {
+    static constexpr float k_frames_per_ms = k_samplerate / 1000.f;
+    const int32_t * r = raw_;
+    attack_ = envAttack(r[k_ref_attack] * k_frames_per_ms);
+    release_ = envDecay(r[k_ref_release] * k_frames_per_ms);
+    pitch_seg_ = envDecay(r[k_ref_decay] * k_frames_per_ms);
+    osc2_seg_ = envDecay(r[k_ref_osc2_decay] * k_frames_per_ms);
+
+    const float pitch = static_cast<float>(r[k_ref_pitch]);
+    const float fm_amount = r[k_ref_fm_amount] / 100.f;
+    const float drive = r[k_ref_drive] / 100.f;
+    pitch_ = pitch;
+    pitch_depth_ = pitch * (r[k_ref_pitch_curve] / 100.f);
+    osc2_inc_ = (r[k_ref_osc2_pitch] / 10.f) * (r[k_ref_fm_ratio] / 10.f) * k_inv_samplerate;
+    fm_depth_ = fm_amount * 100.f;
+    body_ = r[k_ref_body_level] / 100.f;
+    osc2_level_ = r[k_ref_osc2_level] / 100.f;
+    click_gain_ = (r[k_ref_click_level] / 100.f) * 3.0f;
+    drive_ = drive > 0.f;
+    drive_pre_ = 1.f + drive * 4.f;
+    drive_post_ = 1.f / (1.f + drive * 1.5f);
+
+    filter_enabled_ = r[k_ref_filter_enabled] > 0;
+    filter_poles_ = r[k_ref_filter_mode] > 0 ? 4 : 2;
+    const float g = filterGain(r[k_ref_filter_cutoff] / 100.f);
+    const float k = (r[k_ref_filter_resonance] / 100.f) * k_filter_max_k;
+    filter_g_ = g;
+    filter_k_ = k;
+    filter_norm_ = 1.f / (1.f + k * (filter_poles_ == 4 ? g * g * g * g : g * g));
+    filter_comp_ = 1.f + 0.5f * k;
+
+    osc2_enabled_ = r[k_ref_osc2_enabled] != 0;
+    wave_ = r[k_ref_osc2_waveform] >= 0 && r[k_ref_osc2_waveform] < k_num_waves
+        ? static_cast<uint8_t>(r[k_ref_osc2_waveform]) : static_cast<uint8_t>(k_wave_sine);
+    fm_ = osc2_enabled_ && fm_amount > 0.f;
+
+    // Click wie ClickCache::render() für den Schlüssel aus resolveClicks()
+    click_inc_ = static_cast<float>(r[k_ref_click_freq]) * k_inv_samplerate;
+    const float dec = 1.f / (static_cast<float>(r[k_ref_click_decay]) / 1000.f * k_samplerate);
+    click_frames_ = 1.f / dec;
+    click_tone_ = r[k_ref_click_tone] / 100.f;
+    click_seg_ = envDecay(click_frames_);
+  }
+
+  inline uint32_t clickLength() const {
+    uint32_t length = click_frames_ < k_click_max_frames ? static_cast<uint32_t>(click_frames_) + 1
+                                                         : static_cast<uint32_t>(k_click_max_frames);
+    return (length + 3) & ~3u;
+  }
+
+  // Ein Sample des Clicks ohne Pegel: Mischung, Hochpass, Envelope
+  inline float clickSample() {
+    const float tonal = sineTier(tier_, refFrac(static_cast<float>(click_pos_ + 1) * click_inc_));
+    const float src = tonal * click_tone_ + click_noise_.Next() * (1.f - click_tone_);
+    const float hp = src - click_prev_ * 0.7f;
+    click_prev_ = src;
+    const float y = hp * (click_env_ > 0.f ? click_env_ : 0.f);
+    click_env_ = click_seg_.b + click_env_ * click_seg_.k;
+    ++click_pos_;
+    return y;
+  }
+
+  inline float osc2Wave(float t, float inc) {
+    const float dt = inc < k_blep_min_inc ? k_blep_min_inc : (inc > k_blep_max_inc ? k_blep_max_inc : inc);
+    switch (wave_) {
+      case k_wave_saw:
+        return waveformSaw(t) - refPolyBlep(t, dt);
+      case k_wave_triangle: {
+        const float corners = refPolyBlamp(refFrac(t + 0.5f), dt) - refPolyBlamp(t, dt);
+        return waveformTriangle(t) + corners * (dt * 4.f);
+      }
+      case k_wave_pulse:
+        return waveformPulse(t, 0.5f) + refPolyBlep(t, dt) - refPolyBlep(refFrac(t - 0.5f), dt);
+      case k_wave_noise:
+        return osc2_noise_.Next();
+      default:
+        return sineTier(tier_, t);
+    }
+  }
+
+  inline float saturate(float x) {
+    if (os_factor_ == k_os_1x) return Saturator::Process(x);
+    float up[2];
+    up1_.Process(x, up);
+    if (os_factor_ == k_os_2x) {
+      up[0] = Saturator::Process(up[0]);
+      up[1] = Saturator::Process(up[1]);
+      return down1_.Process(up);
+    }
+    float up4[4];
+    up2_.Process(up[0], up4);
+    up2_.Process(up[1], up4 + 2);
+    for (float & s : up4) s = Saturator::Process(s);
+    float mid[2] = {down2_.Process(up4), down2_.Process(up4 + 2)};
+    return down1_.Process(mid);
+  }
+
+  // TPT-Ladder wie Synth::renderFilter()
+  inline float filter(float in) {
+    const float g = filter_g_;
+    float sigma = filter_[0];
+    float gn = g;
+    for (size_t p = 1; p < filter_poles_; ++p) {
+      sigma = filter_[p] + sigma * g;
+      gn *= g;
+    }
+    sigma *= 1.f - g;
+    const float x = in * filter_comp_;
+    const float y = (sigma + gn * x) * filter_norm_;
+    float u = x - y * filter_k_;
+    for (size_t p = 0; p < filter_poles_; ++p) {
+      const float v = (u - filter_[p]) * g;
+      u = v + filter_[p];
+      filter_[p] = u + v;
+    }
+    return u;
+  }
+
+  float process() {
+    // Envelopes: Attack bis 1, danach fallend bis 0 (Decay und Release)
+    if (state_ == k_ref_state_attack) {
+      env_ = attack_.b + env_ * attack_.k;
+      if (env_ >= 1.f) {
+        env_ = 1.f;
+        state_ = k_ref_state_falling;
+      }
+    } else if (state_ == k_ref_state_falling) {
+      env_ = release_.b + env_ * release_.k;
+      if (env_ <= 0.f) {
+        env_ = 0.f;
+        state_ = k_ref_state_off;
+      }
+    }
+    if (state_ != k_ref_state_off) {
+      pitch_env_ = std::fmax(pitch_seg_.b + pitch_env_ * pitch_seg_.k, 0.f);
+      osc2_env_ = std::fmax(osc2_seg_.b + osc2_env_ * osc2_seg_.k, 0.f);
+    }
+
+    // Oszillatoren, FM mit der Phase von OSC2 vor dem Schritt
+    const float current_pitch = pitch_ - pitch_env_ * pitch_depth_;
+    const float inc2 = current_pitch * osc2_inc_;
+    const float phase2_old = phase2_;
+    phase2_ = refFrac(phase2_ + inc2);
+    float freq = current_pitch;
+    if (fm_) freq += sineTier(tier_, phase2_old) * fm_depth_ * osc2_env_;
+    phase1_ = refFrac(phase1_ + freq * k_inv_samplerate);
+    float mix = sineTier(tier_, phase1_) * body_;
+    if (osc2_enabled_) mix += osc2Wave(phase2_, inc2) * osc2_level_ * osc2_env_;
+    if (click_pos_ < click_length_) mix += clickSample() * click_gain_;
+
+    // Drive und Filter
+    if (drive_) mix = saturate(mix * drive_pre_) * drive_post_;
+    if (filter_enabled_) mix = filter(mix);
+
+    const float out = mix * env_ * (1.3f * velocity_);
+    return out > 1.f ? 1.f : (out < -1.f ? -1.f : out);
+  }
+
+  int32_t raw_[k_ref_num_params];  // Parameter-Einheiten wie header.c
+  uint8_t tier_;                   // k_sine_*
+  uint8_t os_factor_;              // k_os_*
+
+  // Koeffizienten
+  EnvSegment attack_, release_, pitch_seg_, osc2_seg_, click_seg_;
+  float pitch_, pitch_depth_, osc2_inc_, fm_depth_, body_, osc2_level_, click_gain_;
+  float drive_pre_, drive_post_;
+  float filter_g_, filter_k_, filter_norm_, filter_comp_;
+  float click_inc_, click_frames_, click_tone_;
+  size_t filter_poles_;
+  uint8_t wave_;
+  bool drive_, filter_enabled_, osc2_enabled_, fm_;
+
+  // Zustand
+  uint32_t state_;
+  float env_, pitch_env_, osc2_env_;
+  float phase1_, phase2_;
+  float velocity_;
+  float filter_[4];
+  NoiseGenerator osc2_noise_;   // Wie Lane 0 von NoiseGenerator4
+  NoiseGenerator click_noise_;
+  uint32_t click_seed_;
+  uint32_t click_pos_, click_length_;
+  float click_prev_, click_env_;
+  RefHalfbandUp<k_hb_2x_pairs> up1_;
+  RefHalfbandUp<k_hb_4x_pairs> up2_;
+  RefHalfbandDown<k_hb_4x_pairs> down2_;
+  RefHalfbandDown<k_hb_2x_pairs> down1_;
+};
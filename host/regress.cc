@@ -0,0 +1,352 @@
+/*
+ *  File: host/regress.cc
+ *
+ *  Behavioural regression checks for the unit API that golden output
+ *  cannot cover: every check drives one or two Synth instances through a
+ *  specific sequence of calls and compares the result bit for bit against
+ *  the same state reached the straightforward way, or, for the batch
+ *  renderer, against the same jobs rendered in another order and on another
+ *  number of threads.
+ *
+ *  Usage:
+ *    regress                 run the checks
+ *    regress <perf-hashes>   also compare against hashes written by a
+ *                            KICK_PERF_STATS build
+ *    regress hashes <file>   write the per-hit hashes for that comparison
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "batch.h"
+
+// Parameter-IDs wie Synth::k_param_* (setParameter)
+enum {
+  k_id_pitch = 0,
+  k_id_decay = 1,
+  k_id_drive = 3,
+  k_id_lfo = 7,
+};
+
+static constexpr uint8_t k_num_presets = 5;
+static constexpr size_t k_block = 64;
+static constexpr size_t k_settle_blocks = 16;  // > k_smooth_frames, Rampen stehen danach
+static constexpr size_t k_hit_frames = 9600;
+static constexpr size_t k_spaced_hit_frames = 48000;  // Länger als jeder Anschlag der Presets
+
+static bool report(const char * name, bool ok, const char * detail) {
+  std::printf("%-4s %-28s %s\n", ok ? "ok" : "FAIL", name, detail);
+  return ok;
+}
+
+static void renderBlocks(Synth & synth, size_t blocks) {
+  alignas(16) static float out[k_block * 2];
+  for (size_t b = 0; b < blocks; ++b) synth.Render(out, k_block);
+}
+
+// Ein Anschlag ab frischem Stimmenzustand, blockweise gerendert
+static std::vector<float> renderHit(Synth & synth) {
+  std::vector<float> out(k_hit_frames * 2);
+  synth.Reset();
+  synth.NoteOn(36, 127);
+  for (size_t pos = 0; pos < k_hit_frames; pos += k_block) {
+    synth.Render(&out[pos * 2], k_block);
+  }
+  return out;
+}
+
+// Erster abweichender Sample-Index, -1 wenn bitgleich
+static long firstDifference(const std::vector<float> & a, const std::vector<float> & b) {
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (std::memcmp(&a[i], &b[i], sizeof(float)) != 0) return static_cast<long>(i);
+  }
+  return -1;
+}
+
+static bool compareHits(const char * name, const std::vector<float> & ref, const std::vector<float> & out) {
+  char detail[64];
+  const long at = firstDifference(ref, out);
+  if (at < 0) {
+    std::snprintf(detail, sizeof(detail), "bit-identical");
+  } else {
+    std::snprintf(detail, sizeof(detail), "differs at sample %ld", at);
+  }
+  return report(name, at < 0, detail);
+}
+
+static Synth s_synth;
+static Synth s_ref;
+
+/*===========================================================================*/
+/* Event queue. */
+/*===========================================================================*/
+
+// Mehr Ereignisse zwischen zwei Blöcken als die Queue fasst: Der Abgleich
+// muss beim zuletzt gesetzten Wert landen, auch wenn ein Presetwechsel und
+// ältere Werte noch in der Queue stehen, und kein Anschlag darf verloren gehen
+static bool checkQueueOverflow() {
+  bool ok = true;
+  s_synth.LoadPreset(0);
+  renderBlocks(s_synth, k_settle_blocks);
+  s_synth.LoadPreset(3);
+  for (int i = 0; i < 4 * static_cast<int>(k_event_queue_size); ++i) {
+    s_synth.setParameter(k_id_decay, 10 + (i * 37) % 490);
+    s_synth.setParameter(k_id_drive, i % 100);
+  }
+  s_synth.setParameter(k_id_decay, 444);
+  s_synth.setParameter(k_id_drive, 77);
+  renderBlocks(s_synth, k_settle_blocks);
+
+  char detail[64];
+  const int32_t decay = s_synth.getParameterValue(k_id_decay);
+  const int32_t drive = s_synth.getParameterValue(k_id_drive);
+  std::snprintf(detail, sizeof(detail), "decay %d drive %d", decay, drive);
+  ok &= report("overflow_parameter_value", decay == 444 && drive == 77, detail);
+
+  s_ref.LoadPreset(3);
+  s_ref.setParameter(k_id_decay, 444);
+  s_ref.setParameter(k_id_drive, 77);
+  renderBlocks(s_ref, k_settle_blocks);
+  ok &= compareHits("overflow_output", renderHit(s_ref), renderHit(s_synth));
+
+  // Anschlag im selben Block wie ein Presetwechsel und ein Schwall
+  // Parameter: Die Parameter laufen über, der Anschlag muss trotzdem kommen
+  s_synth.Reset();
+  s_synth.LoadPreset(0);
+  for (int i = 0; i < 4 * static_cast<int>(k_event_queue_size); ++i) {
+    s_synth.setParameter(k_id_drive, i % 100);
+  }
+  s_synth.NoteOn(36, 127);
+  std::vector<float> hit(k_hit_frames * 2);
+  for (size_t pos = 0; pos < k_hit_frames; pos += k_block) {
+    s_synth.Render(&hit[pos * 2], k_block);
+  }
+  float peak = 0.f;
+  for (float x : hit) peak = x > peak ? x : (-x > peak ? -x : peak);
+  std::snprintf(detail, sizeof(detail), "peak %.3f", peak);
+  ok &= report("overflow_note", peak > 0.1f, detail);
+  return ok;
+}
+
+/*===========================================================================*/
+/* Presets. */
+/*===========================================================================*/
+
+// Ein Benutzer-Slot wird überschrieben, während sein Laden noch aussteht:
+// Der Render-Thread muss das geladene Preset übernehmen, nicht das neue
+static bool checkPresetStoreWhilePending() {
+  bool ok = true;
+  s_synth.LoadPreset(2);
+  s_synth.setParameter(k_id_decay, 320);
+  renderBlocks(s_synth, k_settle_blocks);
+  s_synth.SaveUserPreset(0, "LOADED");
+
+  KickPreset other;
+  std::memset(&other, 0, sizeof(other));
+  std::strncpy(other.name, "OTHER", k_preset_name_len - 1);
+  for (uint8_t id = 0; id < k_preset_num_params; ++id) {
+    other.params[id] = static_cast<int16_t>(s_synth.getParameterValue(id));
+  }
+  other.params[k_id_decay] = 40;
+  other.params[k_id_drive] = 90;
+
+  s_synth.LoadPreset(k_num_presets);
+  s_synth.StoreUserPreset(0, other);
+  renderBlocks(s_synth, k_settle_blocks);
+
+  char detail[64];
+  const int32_t decay = s_synth.getParameterValue(k_id_decay);
+  std::snprintf(detail, sizeof(detail), "decay %d", decay);
+  ok &= report("preset_store_parameter_value", decay == 320, detail);
+
+  s_ref.LoadPreset(2);
+  s_ref.setParameter(k_id_decay, 320);
+  renderBlocks(s_ref, k_settle_blocks);
+  ok &= compareHits("preset_store_output", renderHit(s_ref), renderHit(s_synth));
+  return ok;
+}
+
+/*===========================================================================*/
+/* Freeze. */
+/*===========================================================================*/
+
+#if defined(KICK_FREEZE) && defined(KICK_SPREAD)
+// Mehrere Anschläge, jeder klingt vor dem nächsten ganz aus
+static std::vector<float> renderSpacedHits(Synth & synth, size_t hits) {
+  std::vector<float> out(hits * k_spaced_hit_frames * 2);
+  synth.Reset();
+  for (size_t h = 0; h < hits; ++h) {
+    synth.NoteOn(36, 127);
+    for (size_t pos = 0; pos < k_spaced_hit_frames; pos += k_block) {
+      synth.Render(&out[(h * k_spaced_hit_frames + pos) * 2], k_block);
+    }
+  }
+  return out;
+}
+
+// Mit Spread muss jeder Anschlag breit bleiben, Freeze darf also nicht
+// die Mono-Aufnahme abspielen: gleiche Ausgabe wie ohne Freeze
+static bool checkFreezeSpread() {
+  s_synth.LoadPreset(1);
+  s_synth.setFreeze(true);
+  s_synth.setSpread(60);
+  renderBlocks(s_synth, k_settle_blocks);
+  s_ref.LoadPreset(1);
+  s_ref.setFreeze(false);
+  s_ref.setSpread(60);
+  renderBlocks(s_ref, k_settle_blocks);
+  const bool ok = compareHits("freeze_with_spread", renderSpacedHits(s_ref, 3), renderSpacedHits(s_synth, 3));
+  s_synth.setFreeze(false);
+  s_synth.setSpread(0);
+  s_ref.setSpread(0);
+  return ok;
+}
+#endif
+
+/*===========================================================================*/
+/* Batch determinism. */
+/*===========================================================================*/
+
+static const int32_t s_lfo_settings[] = {0, 2, 8, 14};  // Aus, Pitch, Cutoff, Drive
+static const int32_t s_batch_pitches[] = {45, 65};
+static constexpr uint32_t k_batch_frames = 24000;
+
+// FNV-1a über die Bits der Ausgabe
+static uint64_t hashSamples(const float * samples, size_t count) {
+  uint64_t h = 14695981039346656037ull;
+  const unsigned char * bytes = reinterpret_cast<const unsigned char *>(samples);
+  for (size_t i = 0; i < count * sizeof(float); ++i) {
+    h = (h ^ bytes[i]) * 1099511628211ull;
+  }
+  return h;
+}
+
+static void hashSink(void * user, size_t job, const float * mono, size_t frames) {
+  (*static_cast<std::vector<uint64_t> *>(user))[job] = hashSamples(mono, frames);
+}
+
+static std::vector<uint64_t> hashJobs(const std::vector<BatchJob> & jobs, size_t threads) {
+  std::vector<uint64_t> hashes(jobs.size());
+  BatchRenderer renderer(threads, k_batch_frames);
+  renderer.Run(jobs.data(), jobs.size(), hashSink, &hashes);
+  return hashes;
+}
+
+// Jeder Job muss unabhängig davon sein, welche Jobs derselbe Worker vorher
+// gerechnet hat: 1 und 3 Threads sowie umgekehrte Reihenfolge, mit LFO
+static bool checkBatchDeterminism() {
+  std::vector<BatchJob> jobs;
+  for (uint8_t p = 0; p < k_num_presets; ++p) {
+    for (int32_t lfo : s_lfo_settings) {
+      for (int32_t pitch : s_batch_pitches) {
+        BatchJob job;
+        std::memset(&job, 0, sizeof(job));
+        job.preset = p;
+        job.note = 60;
+        job.velocity = 127;
+        job.num_params = 2;
+        job.params[0] = {k_id_lfo, lfo};
+        job.params[1] = {k_id_pitch, pitch};
+        job.frames = k_batch_frames;
+        job.seed = k_noise_default_seed;
+        jobs.push_back(job);
+      }
+    }
+  }
+  const std::vector<BatchJob> reversed(jobs.rbegin(), jobs.rend());
+
+  const std::vector<uint64_t> one = hashJobs(jobs, 1);
+  const std::vector<uint64_t> three = hashJobs(jobs, 3);
+  const std::vector<uint64_t> backwards = hashJobs(reversed, 1);
+  size_t differing = 0;
+  for (size_t j = 0; j < jobs.size(); ++j) {
+    if (three[j] != one[j] || backwards[jobs.size() - 1 - j] != one[j]) ++differing;
+  }
+  char detail[64];
+  std::snprintf(detail, sizeof(detail), "%zu of %zu jobs differ", differing, jobs.size());
+  return report("batch_threads_and_order", differing == 0, detail);
+}
+
+/*===========================================================================*/
+/* Perf-stats build. */
+/*===========================================================================*/
+
+// Ein Anschlag je Preset und LFO-Einstellung. Der CPU-Last-Slot ersetzt
+// mit KICK_PERF_STATS die LFO-Tiefe, der Klang muss trotzdem derselbe sein
+static std::vector<uint64_t> hashPresetHits() {
+  std::vector<uint64_t> hashes;
+  for (uint8_t p = 0; p < k_num_presets; ++p) {
+    for (int32_t lfo : s_lfo_settings) {
+      s_synth.LoadPreset(p);
+      s_synth.setParameter(k_id_lfo, lfo);
+      renderBlocks(s_synth, k_settle_blocks);
+      const std::vector<float> out = renderHit(s_synth);
+      hashes.push_back(hashSamples(out.data(), out.size()));
+    }
+  }
+  return hashes;
+}
+
+static bool writeHashes(const char * path) {
+  FILE * f = std::fopen(path, "w");
+  if (!f) {
+    std::fprintf(stderr, "cannot write %s\n", path);
+    return false;
+  }
+  for (uint64_t h : hashPresetHits()) std::fprintf(f, "%016llx\n", static_cast<unsigned long long>(h));
+  std::fclose(f);
+  return true;
+}
+
+// path: Hashes aus dem Build mit KICK_PERF_STATS (regress hashes <path>)
+static bool checkPerfStatsOutput(const char * path) {
+  std::vector<uint64_t> other;
+  if (FILE * f = std::fopen(path, "r")) {
+    unsigned long long h;
+    while (std::fscanf(f, "%llx", &h) == 1) other.push_back(h);
+    std::fclose(f);
+  }
+  const std::vector<uint64_t> own = hashPresetHits();
+  size_t differing = 0;
+  for (size_t i = 0; i < own.size(); ++i) {
+    if (i >= other.size() || other[i] != own[i]) ++differing;
+  }
+  char detail[64];
+  std::snprintf(detail, sizeof(detail), "%zu of %zu hits differ", differing, own.size());
+  return report("perf_stats_output", differing == 0, detail);
+}
+
+int main(int argc, char ** argv) {
+  if (argc == 3 && std::strcmp(argv[1], "hashes") == 0) {
+    return writeHashes(argv[2]) ? 0 : 1;
+  }
+  if (argc > 2) {
+    std::fprintf(stderr, "usage: regress [perf-hashes] | regress hashes <file>\n");
+    return 2;
+  }
+
+  size_t failures = 0;
+  size_t checks = 0;
+  bool (*const s_checks[])() = {
+    checkQueueOverflow,
+    checkPresetStoreWhilePending,
+#if defined(KICK_FREEZE) && defined(KICK_SPREAD)
+    checkFreezeSpread,
+#endif
+    checkBatchDeterminism,
+  };
+  for (bool (*check)() : s_checks) {
+    ++checks;
+    if (!check()) ++failures;
+  }
+  if (argc == 2) {
+    ++checks;
+    if (!checkPerfStatsOutput(argv[1])) ++failures;
+  }
+  std::printf("%zu of %zu checks failed\n", failures, checks);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+/*
+ *  File: host/unit.h
+ *
+ *  Minimal stand-in for the drumlogue SDK unit.h (../common/unit.h) so the
+ *  synth headers can be built and run on a host without the runtime.
+ *  Only the parts used by synth.h and the host tools are provided.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <stdint.h>
+
+#ifndef fast_inline
+#define fast_inline inline __attribute__((always_inline))
+#endif
+
+#define UNIT_TARGET_PLATFORM (0x4 << 8)  // drumlogue
+#define UNIT_API_VERSION 0x00010000U
+
+typedef struct unit_runtime_desc {
+  uint16_t target;
+  uint32_t api;
+  uint32_t samplerate;
+  uint16_t frames_per_buffer;
+  uint8_t input_channels;
+  uint8_t output_channels;
+  uint8_t padding[2];
+} unit_runtime_desc_t;
+
+enum {
+  k_unit_err_none = 0,
+  k_unit_err_target = -1,
+  k_unit_err_api_version = -2,
+  k_unit_err_samplerate = -4,
+  k_unit_err_geometry = -8,
+  k_unit_err_memory = -16,
+  k_unit_err_undef = -32,
+};
@@ -0,0 +1,233 @@
+#pragma once
+/*
+ *  File: host/wav_writer.h
+ *
+ *  Streaming WAV writer for the host tools. Synth::Render/RenderMono
+ *  write straight into the writer's buffer (Acquire/Commit), so there is
+ *  no intermediate copy. Two buffers alternate: while one is filled, a
+ *  background thread writes the other to disk. Float32 is written as
+ *  rendered, int24 is packed in place before the buffer is handed over.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <arm_neon.h>
+
+static constexpr size_t k_wav_buffer_frames = 16384;  // Frames pro Puffer (Voreinstellung)
+static constexpr size_t k_wav_header_bytes = 44;
+
+enum {
+  k_wav_float32 = 0,  // IEEE float, wie von Render() geliefert
+  k_wav_int24,        // PCM 24 Bit, auf [-1, 1] begrenzt
+  k_num_wav_formats
+};
+
+class WavWriter {
+public:
+  explicit WavWriter(size_t buffer_frames = k_wav_buffer_frames)
+      : buffer_frames_(buffer_frames), file_(nullptr), channels_(0), format_(k_wav_float32), fill_(0),
+        frames_(0), ok_(false), pending_(nullptr), pending_bytes_(0), quit_(false) {
+    // Stereo-Platz, Mono nutzt die erste Hälfte
+    buffers_[0].resize(buffer_frames * 2);
+    buffers_[1].resize(buffer_frames * 2);
+    active_ = buffers_[0].data();
+    thread_ = std::thread([this] { writerLoop(); });
+  }
+
+  ~WavWriter(void) {
+    Close();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      quit_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+  WavWriter(const WavWriter &) = delete;
+  WavWriter & operator=(const WavWriter &) = delete;
+
+  // channels: 1 (RenderMono) oder 2 (Render), format: k_wav_*
+  bool Open(const char * path, uint8_t channels, uint8_t format) {
+    Close();
+    if (channels < 1 || channels > 2 || format >= k_num_wav_formats) return false;
+    file_ = std::fopen(path, "wb");
+    if (!file_) return false;
+    channels_ = channels;
+    format_ = format;
+    fill_ = 0;
+    frames_ = 0;
+    ok_ = true;
+    active_ = buffers_[0].data();
+    writeHeader();  // Größen werden in Close() nachgetragen
+    return ok_;
+  }
+
+  inline bool IsOpen() const {
+    return file_ != nullptr;
+  }
+
+  // Platz für bis zu frames Frames im Interleave-Layout der Datei, als Ziel
+  // für Render()/RenderMono(). frames wird auf den Rest des Puffers gekürzt
+  inline float * Acquire(size_t & frames) {
+    if (fill_ == buffer_frames_) flush();
+    if (frames > buffer_frames_ - fill_) frames = buffer_frames_ - fill_;
+    return active_ + fill_ * channels_;
+  }
+
+  // frames der zuletzt über Acquire() geholten Frames sind geschrieben
+  inline void Commit(size_t frames) {
+    fill_ += frames;
+    frames_ += frames;
+  }
+
+  // Schreibt den Rest, trägt die Größen im Header nach und schließt die
+  // Datei. false, wenn irgendein Schreibzugriff fehlgeschlagen ist
+  bool Close() {
+    if (!file_) return true;
+    if (fill_) flush();
+    waitIdle();
+    const uint32_t data_bytes = static_cast<uint32_t>(frames_ * channels_ * sampleBytes());
+    uint8_t sizes[4];
+    put32(sizes, 36 + data_bytes);
+    ok_ = ok_ && std::fseek(file_, 4, SEEK_SET) == 0 && std::fwrite(sizes, 4, 1, file_) == 1;
+    put32(sizes, data_bytes);
+    ok_ = ok_ && std::fseek(file_, 40, SEEK_SET) == 0 && std::fwrite(sizes, 4, 1, file_) == 1;
+    ok_ = std::fclose(file_) == 0 && ok_;
+    file_ = nullptr;
+    return ok_;
+  }
+
+  inline size_t Frames() const {
+    return frames_;
+  }
+
+private:
+  static inline void put16(uint8_t * p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+  }
+
+  static inline void put32(uint8_t * p, uint32_t v) {
+    put16(p, static_cast<uint16_t>(v));
+    put16(p + 2, static_cast<uint16_t>(v >> 16));
+  }
+
+  inline size_t sampleBytes() const {
+    return format_ == k_wav_int24 ? 3 : sizeof(float);
+  }
+
+  void writeHeader() {
+    const uint32_t block_align = static_cast<uint32_t>(channels_ * sampleBytes());
+    uint8_t header[k_wav_header_bytes];
+    std::memcpy(header, "RIFF", 4);
+    put32(header + 4, 36);
+    std::memcpy(header + 8, "WAVEfmt ", 8);
+    put32(header + 16, 16);
+    put16(header + 20, format_ == k_wav_int24 ? 1 : 3);  // WAVE_FORMAT_PCM / _IEEE_FLOAT
+    put16(header + 22, channels_);
+    put32(header + 24, 48000);
+    put32(header + 28, 48000 * block_align);
+    put16(header + 32, static_cast<uint16_t>(block_align));
+    put16(header + 34, format_ == k_wav_int24 ? 24 : 32);
+    std::memcpy(header + 36, "data", 4);
+    put32(header + 40, 0);
+    ok_ = std::fwrite(header, sizeof(header), 1, file_) == 1;
+  }
+
+  // float -> int24 little-endian im selben Puffer. Das Ziel (3 Byte pro
+  // Sample) liegt nie hinter der Quelle (4 Byte), vorwärts ist also sicher
+  static size_t packInt24(float * buf, size_t samples) {
+    uint8_t * dst = reinterpret_cast<uint8_t *>(buf);
+    const float32x4_t lo = vdupq_n_f32(-1.f);
+    const float32x4_t hi = vdupq_n_f32(1.f);
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+      const float32x4_t x = vminq_f32(vmaxq_f32(vld1q_f32(buf + i), lo), hi);
+      int32_t s[4];
+      vst1q_s32(s, vcvtq_s32_f32(vmulq_n_f32(x, 8388607.f)));
+      for (size_t k = 0; k < 4; ++k) {
+        dst[0] = static_cast<uint8_t>(s[k]);
+        dst[1] = static_cast<uint8_t>(s[k] >> 8);
+        dst[2] = static_cast<uint8_t>(s[k] >> 16);
+        dst += 3;
+      }
+    }
+    for (; i < samples; ++i) {
+      float x = buf[i];
+      if (x > 1.f) x = 1.f;
+      if (x < -1.f) x = -1.f;
+      const int32_t s = static_cast<int32_t>(x * 8388607.f);
+      dst[0] = static_cast<uint8_t>(s);
+      dst[1] = static_cast<uint8_t>(s >> 8);
+      dst[2] = static_cast<uint8_t>(s >> 16);
+      dst += 3;
+    }
+    return samples * 3;
+  }
+
+  // Übergibt den aktiven Puffer an den Schreib-Thread und wechselt auf den
+  // anderen; wartet nur, wenn die Platte den vorigen noch nicht geschrieben hat
+  void flush() {
+    const size_t samples = fill_ * channels_;
+    const size_t bytes = format_ == k_wav_int24 ? packInt24(active_, samples) : samples * sizeof(float);
+    waitIdle();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_ = active_;
+      pending_bytes_ = bytes;
+    }
+    cv_.notify_all();
+    active_ = active_ == buffers_[0].data() ? buffers_[1].data() : buffers_[0].data();
+    fill_ = 0;
+  }
+
+  void waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return pending_ == nullptr; });
+  }
+
+  void writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      cv_.wait(lock, [this] { return pending_ != nullptr || quit_; });
+      if (pending_ == nullptr) return;  // quit_
+      const float * buf = pending_;
+      const size_t bytes = pending_bytes_;
+      lock.unlock();
+      const bool ok = std::fwrite(buf, 1, bytes, file_) == bytes;  // Host ist little-endian
+      lock.lock();
+      if (!ok) ok_ = false;
+      pending_ = nullptr;
+      cv_.notify_all();
+    }
+  }
+
+  size_t buffer_frames_;
+  std::vector<float> buffers_[2];  // buffer_frames_ Stereo-Frames
+  float * active_;                  // Wird gerade gefüllt
+  FILE * file_;
+  uint8_t channels_;
+  uint8_t format_;
+  size_t fill_;    // Frames im aktiven Puffer
+  size_t frames_;  // Frames in der Datei insgesamt
+  bool ok_;
+
+  // Übergabe an den Schreib-Thread, geschützt durch mutex_
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  const float * pending_;
+  size_t pending_bytes_;
+  bool quit_;
+  std::thread thread_;
+};
@@ -0,0 +1,95 @@
+#pragma once
+/*
+ *  File: lfo.h
+ *
+ *  Tempo-synced modulation LFO. Runs at block rate: the synth advances it
+ *  once per block and reads one value, the block renderer interpolates
+ *  the modulated coefficients linearly across the block. The tempo comes
+ *  from unit_set_tempo as 16.16 fixed-point BPM. Phase and increment are
+ *  Q32 integers, so the fixed-point kernel reads the same phase as the
+ *  float kernel without any float arithmetic.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sine.h"
+
+static constexpr uint32_t k_lfo_default_tempo = 120u << 16;  // 120 BPM
+static constexpr uint32_t k_lfo_min_tempo = 20u << 16;       // Darunter steht das LFO praktisch
+
+// Periode in Notenwerten
+enum {
+  k_lfo_rate_16th = 0,
+  k_lfo_rate_8th,
+  k_lfo_rate_4th,
+  k_lfo_rate_half,
+  k_lfo_rate_bar,
+  k_lfo_rate_2bars,
+  k_num_lfo_rates
+};
+
+// Sechzehntel pro Periode, Index = k_lfo_rate_*
+static constexpr uint32_t k_lfo_rate_16ths[k_num_lfo_rates] = {1, 2, 4, 8, 16, 32};
+
+// Freilaufender Sinus; ohne Songposition vom Runtime läuft er unabhängig
+// von den Anschlägen und hält nur das Tempo
+class TempoLfo {
+public:
+  TempoLfo(void) : phase_(0), inc_(0), samplerate_(48000), tempo_(k_lfo_default_tempo), rate_(k_lfo_rate_4th) {}
+
+  inline void Init(uint32_t samplerate) {
+    samplerate_ = samplerate;
+    phase_ = 0;
+    update();
+  }
+
+  // Zurück an den Periodenanfang, Tempo und Rate bleiben
+  inline void Reset() {
+    phase_ = 0;
+  }
+
+  // 16.16 Festkomma in BPM
+  inline void SetTempo(uint32_t tempo) {
+    tempo_ = tempo < k_lfo_min_tempo ? k_lfo_min_tempo : tempo;
+    update();
+  }
+
+  inline void SetRate(uint8_t rate) {
+    rate_ = rate < k_num_lfo_rates ? rate : static_cast<uint8_t>(k_lfo_rate_4th);
+    update();
+  }
+
+  // Die Phase wickelt als uint32 von selbst
+  inline void Advance(size_t frames) {
+    phase_ += inc_ * static_cast<uint32_t>(frames);
+  }
+
+  // -1 .. 1 an der aktuellen Phase
+  inline float Value() const {
+    return sineTier(k_sine_poly7, static_cast<float>(phase_) * (1.f / 4294967296.f));
+  }
+
+  // Q32, eine Periode = 2^32
+  inline uint32_t Phase() const {
+    return phase_;
+  }
+
+private:
+  // Perioden pro Sample = BPM / 60 / Schläge pro Periode / Samplerate, mit
+  // BPM = tempo_ / 2^16 und Schläge = Sechzehntel / 4: in Q32 also
+  // tempo_ * 2^18 / (60 * Sechzehntel * Samplerate)
+  inline void update() {
+    const uint64_t den = 60ull * k_lfo_rate_16ths[rate_] * samplerate_;
+    inc_ = static_cast<uint32_t>((static_cast<uint64_t>(tempo_) << 18) / den);
+  }
+
+  uint32_t phase_;  // Q32
+  uint32_t inc_;    // Phase pro Sample, Q32
+  uint32_t samplerate_;
+  uint32_t tempo_;
+  uint8_t rate_;
+};
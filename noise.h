@@ -0,0 +1,136 @@
+#pragma once
+/*
+ *  File: noise.h
+ *
+ *  Per-instance white noise generator (32-bit LCG) with a 4-lane NEON
+ *  block version that produces exactly the same sequence as Next(), and
+ *  a variant with one independent sequence per NEON lane (per voice).
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <arm_neon.h>
+
+#include "simd.h"
+
+static constexpr uint32_t k_noise_default_seed = 0x12345678u;
+
+// LCG-Zustände -> Samples in [-1, 1): Mantisse aus den oberen 23 Bit, [2, 4) - 3
+fast_inline float32x4_t vnoise_to_f32(uint32x4_t x) {
+  const uint32x4_t bits = vorrq_u32(vshrq_n_u32(x, 9), vdupq_n_u32(0x40000000u));
+  return vsubq_f32(vreinterpretq_f32_u32(bits), vdupq_n_f32(3.f));
+}
+
+class NoiseGenerator {
+public:
+  // LCG-Konstanten (Numerical Recipes) und die Sprungkonstanten für 4 Schritte
+  static constexpr uint32_t k_mul = 1664525u;
+  static constexpr uint32_t k_add = 1013904223u;
+  static constexpr uint32_t k_mul4 = k_mul * k_mul * k_mul * k_mul;
+  static constexpr uint32_t k_add4 = k_add * (k_mul * k_mul * k_mul + k_mul * k_mul + k_mul + 1u);
+
+  NoiseGenerator(void) : state_(k_noise_default_seed) {}
+
+  inline void Seed(uint32_t seed) {
+    state_ = seed;
+  }
+
+  // Ein Sample in [-1, 1)
+  fast_inline float Next() {
+    state_ = state_ * k_mul + k_add;
+    return toFloat(state_);
+  }
+
+  // Wie Next(), als Q31 (Festkomma-Kernel): x - 2^31
+  fast_inline int32_t NextQ31() {
+    state_ = state_ * k_mul + k_add;
+    return static_cast<int32_t>(state_ ^ 0x80000000u);
+  }
+
+  // n Samples, identisch zu n Aufrufen von Next()
+  inline void Render(float * __restrict dst, size_t n) {
+    size_t i = 0;
+    if (n >= 4) {
+      uint32_t s[4];
+      s[0] = state_ * k_mul + k_add;
+      s[1] = s[0] * k_mul + k_add;
+      s[2] = s[1] * k_mul + k_add;
+      s[3] = s[2] * k_mul + k_add;
+      uint32x4_t x = vld1q_u32(s);
+      const uint32x4_t mul4 = vdupq_n_u32(k_mul4);
+      const uint32x4_t add4 = vdupq_n_u32(k_add4);
+      uint32x4_t last = x;
+      for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vnoise_to_f32(x));
+        last = x;
+        x = vmlaq_u32(add4, x, mul4);
+      }
+      state_ = vgetq_lane_u32(last, 3);
+    }
+    for (; i < n; ++i) {
+      dst[i] = Next();
+    }
+  }
+
+private:
+  static fast_inline float toFloat(uint32_t x) {
+    const uint32_t bits = (x >> 9) | 0x40000000u;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f - 3.f;
+  }
+
+  uint32_t state_;
+};
+
+// Vier unabhängige Folgen desselben LCG, eine pro NEON-Lane (Stimme)
+class NoiseGenerator4 {
+public:
+  NoiseGenerator4(void) {
+    Seed(k_noise_default_seed);
+  }
+
+  // Lane i startet bei seed ^ (i * 0x9E3779B9), Lane 0 also bei seed
+  inline void Seed(uint32_t seed) {
+    for (uint32_t i = 0; i < 4; ++i) {
+      state_[i] = seed ^ (i * 0x9E3779B9u);
+    }
+  }
+
+  inline void SeedLane(size_t lane, uint32_t seed) {
+    state_[lane] = seed;
+  }
+
+  // frames Vektoren nach dst, Layout [Frame][Lane]
+  inline void Render(float * __restrict dst, size_t frames) {
+    const uint32x4_t mul = vdupq_n_u32(NoiseGenerator::k_mul);
+    const uint32x4_t add = vdupq_n_u32(NoiseGenerator::k_add);
+    uint32x4_t x = vld1q_u32(state_);
+    for (size_t i = 0; i < frames; ++i) {
+      x = vmlaq_u32(add, x, mul);
+      vst1q_f32(dst + (i << 2), vnoise_to_f32(x));
+    }
+    vst1q_u32(state_, x);
+  }
+
+  // Wie Render(), als Q31 (Festkomma-Kernel): x - 2^31, dieselbe Folge
+  inline void RenderQ31(int32_t * __restrict dst, size_t frames) {
+    const uint32x4_t mul = vdupq_n_u32(NoiseGenerator::k_mul);
+    const uint32x4_t add = vdupq_n_u32(NoiseGenerator::k_add);
+    const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+    uint32x4_t x = vld1q_u32(state_);
+    for (size_t i = 0; i < frames; ++i) {
+      x = vmlaq_u32(add, x, mul);
+      vst1q_s32(dst + (i << 2), vreinterpretq_s32_u32(veorq_u32(x, sign)));
+    }
+    vst1q_u32(state_, x);
+  }
+
+private:
+  alignas(16) uint32_t state_[4];
+};
@@ -0,0 +1,124 @@
+#pragma once
+/*
+ *  File: osc.h
+ *
+ *  OSC2 waveforms as 4-lane NEON block kernels, naive and band-limited.
+ *  The band-limited versions subtract a two-sample polynomial residual at
+ *  each discontinuity: PolyBLEP for the steps of saw and pulse, PolyBLAMP
+ *  for the corners of the triangle. Each lane carries its own phase
+ *  increment, so the correction follows pitch envelope and FM per voice.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include <arm_neon.h>
+
+#include "simd.h"
+
+// Kleinstes und größtes Phaseninkrement der Korrektur: darunter ist der
+// Sprung ohnehin nur eine Lane breit, über 0.5 überlappen die Residuen
+static constexpr float k_blep_min_inc = 1e-5f;
+static constexpr float k_blep_max_inc = 0.5f;
+
+/*===========================================================================*/
+/* Residuals. */
+/*===========================================================================*/
+
+// Residuum eines Sprungs von -1 auf +1 bei Phase 0: -(t/dt - 1)^2 direkt
+// nach dem Sprung, ((t - 1)/dt + 1)^2 direkt davor, sonst 0
+fast_inline float32x4_t vpolyblep_f32(float32x4_t t, float32x4_t dt, float32x4_t inv_dt) {
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t a = vmlaq_f32(vdupq_n_f32(-1.f), t, inv_dt);  // t/dt - 1
+  const float32x4_t b = vmlaq_f32(one, vsubq_f32(t, one), inv_dt);  // (t - 1)/dt + 1
+  const float32x4_t after = vnegq_f32(vmulq_f32(a, a));
+  const float32x4_t before = vmulq_f32(b, b);
+  const uint32x4_t is_after = vcltq_f32(t, dt);
+  const uint32x4_t is_before = vcgtq_f32(t, vsubq_f32(one, dt));
+  return vbslq_f32(is_after, after, vbslq_f32(is_before, before, vdupq_n_f32(0.f)));
+}
+
+// Residuum eines Knicks um +2 dt Steigung pro Sample bei Phase 0 (Integral
+// des PolyBLEP): -(t/dt - 1)^3 / 3 danach, ((t - 1)/dt + 1)^3 / 3 davor,
+// mal dt
+fast_inline float32x4_t vpolyblamp_f32(float32x4_t t, float32x4_t dt, float32x4_t inv_dt) {
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t third = vdupq_n_f32(1.f / 3.f);
+  const float32x4_t a = vmlaq_f32(vdupq_n_f32(-1.f), t, inv_dt);
+  const float32x4_t b = vmlaq_f32(one, vsubq_f32(t, one), inv_dt);
+  const float32x4_t after = vnegq_f32(vmulq_f32(vmulq_f32(vmulq_f32(a, a), a), third));
+  const float32x4_t before = vmulq_f32(vmulq_f32(vmulq_f32(b, b), b), third);
+  const uint32x4_t is_after = vcltq_f32(t, dt);
+  const uint32x4_t is_before = vcgtq_f32(t, vsubq_f32(one, dt));
+  return vbslq_f32(is_after, after, vbslq_f32(is_before, before, vdupq_n_f32(0.f)));
+}
+
+/*===========================================================================*/
+/* Block Kernels. */
+/*===========================================================================*/
+
+// Alle Kernel: dst[i] aus phase[i] in [0, 1) und dem Inkrement inc[i] pro
+// Sample für i < lanes (Vielfaches von 4), in-place erlaubt. Die naiven
+// Kernel ignorieren inc.
+
+// 2t - 1, Sprung um -2 bei Phase 0
+template <bool kBandlimited>
+inline void sawBlock(float * dst, const float * phase, const float * inc, size_t lanes) {
+  const float32x4_t min_inc = vdupq_n_f32(k_blep_min_inc);
+  const float32x4_t max_inc = vdupq_n_f32(k_blep_max_inc);
+  for (size_t i = 0; i < lanes; i += 4) {
+    const float32x4_t t = vld1q_f32(phase + i);
+    float32x4_t y = vmlaq_n_f32(vdupq_n_f32(-1.f), t, 2.f);
+    if (kBandlimited) {
+      const float32x4_t dt = vminq_f32(vmaxq_f32(vld1q_f32(inc + i), min_inc), max_inc);
+      y = vsubq_f32(y, vpolyblep_f32(t, dt, vrecip_f32(dt)));
+    }
+    vst1q_f32(dst + i, y);
+  }
+}
+
+// +1 unterhalb von width, sonst -1: Sprung um +2 bei 0, um -2 bei width
+template <bool kBandlimited>
+inline void pulseBlock(float * dst, const float * phase, const float * inc, size_t lanes, float width) {
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t minus_one = vdupq_n_f32(-1.f);
+  const float32x4_t w = vdupq_n_f32(width);
+  const float32x4_t min_inc = vdupq_n_f32(k_blep_min_inc);
+  const float32x4_t max_inc = vdupq_n_f32(k_blep_max_inc);
+  for (size_t i = 0; i < lanes; i += 4) {
+    const float32x4_t t = vld1q_f32(phase + i);
+    float32x4_t y = vbslq_f32(vcltq_f32(t, w), one, minus_one);
+    if (kBandlimited) {
+      const float32x4_t dt = vminq_f32(vmaxq_f32(vld1q_f32(inc + i), min_inc), max_inc);
+      const float32x4_t inv_dt = vrecip_f32(dt);
+      y = vaddq_f32(y, vpolyblep_f32(t, dt, inv_dt));
+      y = vsubq_f32(y, vpolyblep_f32(vfrac_f32(vsubq_f32(t, w)), dt, inv_dt));
+    }
+    vst1q_f32(dst + i, y);
+  }
+}
+
+// 2|2t - 1| - 1: Spitze bei 0 (Knick -8 dt pro Sample), Tal bei 0.5 (+8 dt)
+template <bool kBandlimited>
+inline void triangleBlock(float * dst, const float * phase, const float * inc, size_t lanes) {
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t half = vdupq_n_f32(0.5f);
+  const float32x4_t min_inc = vdupq_n_f32(k_blep_min_inc);
+  const float32x4_t max_inc = vdupq_n_f32(k_blep_max_inc);
+  for (size_t i = 0; i < lanes; i += 4) {
+    const float32x4_t t = vld1q_f32(phase + i);
+    const float32x4_t ramp = vmlaq_n_f32(vnegq_f32(one), t, 2.f);
+    float32x4_t y = vmlaq_n_f32(vnegq_f32(one), vabsq_f32(ramp), 2.f);
+    if (kBandlimited) {
+      const float32x4_t dt = vminq_f32(vmaxq_f32(vld1q_f32(inc + i), min_inc), max_inc);
+      const float32x4_t inv_dt = vrecip_f32(dt);
+      const float32x4_t corners = vsubq_f32(vpolyblamp_f32(vfrac_f32(vaddq_f32(t, half)), dt, inv_dt),
+                                            vpolyblamp_f32(t, dt, inv_dt));
+      y = vmlaq_f32(y, corners, vmulq_n_f32(dt, 4.f));  // Knick 8 dt = 4 * Residuum
+    }
+    vst1q_f32(dst + i, y);
+  }
+}
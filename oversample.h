@@ -0,0 +1,126 @@
+#pragma once
+/*
+ *  File: oversample.h
+ *
+ *  2x polyphase half-band interpolator and decimator for blocks in the
+ *  [frame][voice] layout of the block renderer: a float32x4_t holds one
+ *  frame of all four voices, so each lane is filtered independently.
+ *  Cascading two stages gives 4x.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <arm_neon.h>
+
+#include "simd.h"
+
+// Oversampling-Faktor der Drive-Stufe
+enum {
+  k_os_1x = 0,
+  k_os_2x,
+  k_os_4x,
+  k_num_os_factors
+};
+
+// Halbband-FIR mit 4 * kPairs - 1 Taps: Mitte 0.5, dazu die symmetrischen
+// Paare an den ungeraden Abständen 1, 3, 5, ... (alle übrigen Taps sind 0).
+// Kaiser-gefensterter Sinc, gemessen bei 96 kHz:
+//
+//   Stufe      Taps   Durchlass          Sperrbereich
+//   k_hb_2x    31     bis 16 kHz 1.6e-4  ab 32 kHz -75.8 dB  (48 <-> 96 kHz)
+//   k_hb_4x    15     bis 20 kHz 5.6e-4  ab 76 kHz -65.1 dB  (96 <-> 192 kHz)
+static constexpr size_t k_hb_2x_pairs = 8;
+static constexpr size_t k_hb_4x_pairs = 4;
+static constexpr float k_hb_2x_c[k_hb_2x_pairs] = {
+  0.3140066338f, -0.0937595460f, 0.0449132285f, -0.0225699887f,
+  0.0106557968f, -0.0043895059f, 0.0014267415f, -0.0002833600f
+};
+static constexpr float k_hb_4x_c[k_hb_4x_pairs] = {
+  0.3048446752f, -0.0712506254f, 0.0194619747f, -0.0030560245f
+};
+
+// Verdoppelt die Rate: frames Vektoren rein, 2 * frames raus.
+// Gerade Ausgänge sind die FIR-Phase, ungerade die verzögerte Eingabe.
+template <size_t kPairs, size_t kMaxFrames>
+class HalfbandUp4 {
+public:
+  static constexpr size_t k_history = 2 * kPairs - 1;  // Vektoren Vorgeschichte
+  static constexpr size_t k_storage_floats = (k_history + kMaxFrames) * 4;
+
+  HalfbandUp4(const float * coeffs) : coeffs_(coeffs), buf_(nullptr) {}
+
+  // storage: k_storage_floats, 16 Byte ausgerichtet
+  inline void Init(float * storage) {
+    buf_ = storage;
+    Reset();
+  }
+
+  inline void Reset() {
+    std::memset(buf_, 0, k_storage_floats * sizeof(float));
+  }
+
+  inline void Process(const float * __restrict src, float * __restrict dst, size_t frames) {
+    // buf_ = [Vorgeschichte | src], Index in Vektoren
+    std::memcpy(buf_ + (k_history << 2), src, (frames << 2) * sizeof(float));
+    for (size_t m = 0; m < frames; ++m) {
+      const float * x = buf_ + ((m + kPairs) << 2);  // x[0] = Eingabe m - kPairs + 1
+      float32x4_t even = vdupq_n_f32(0.f);
+      for (size_t i = 0; i < kPairs; ++i) {
+        const float32x4_t pair = vaddq_f32(vld1q_f32(x + (i << 2)), vld1q_f32(x - ((i + 1) << 2)));
+        even = vmlaq_n_f32(even, pair, 2.f * coeffs_[i]);  // Faktor 2 gleicht die Nullen aus
+      }
+      vst1q_f32(dst + (m << 3), even);
+      vst1q_f32(dst + (m << 3) + 4, vld1q_f32(x));
+    }
+    std::memmove(buf_, buf_ + (frames << 2), (k_history << 2) * sizeof(float));
+  }
+
+private:
+  const float * coeffs_;
+  float * buf_;  // [Vorgeschichte | Block]
+};
+
+// Halbiert die Rate: 2 * frames Vektoren rein, frames raus
+template <size_t kPairs, size_t kMaxFrames>
+class HalfbandDown4 {
+public:
+  static constexpr size_t k_history = 4 * kPairs - 2;  // Vektoren Vorgeschichte
+  static constexpr size_t k_storage_floats = (k_history + 2 * kMaxFrames) * 4;
+
+  HalfbandDown4(const float * coeffs) : coeffs_(coeffs), buf_(nullptr) {}
+
+  // storage: k_storage_floats, 16 Byte ausgerichtet
+  inline void Init(float * storage) {
+    buf_ = storage;
+    Reset();
+  }
+
+  inline void Reset() {
+    std::memset(buf_, 0, k_storage_floats * sizeof(float));
+  }
+
+  inline void Process(const float * __restrict src, float * __restrict dst, size_t frames) {
+    const size_t in_frames = frames << 1;
+    std::memcpy(buf_ + (k_history << 2), src, (in_frames << 2) * sizeof(float));
+    for (size_t m = 0; m < frames; ++m) {
+      // z[0] = Eingabe 2 * (m - kPairs) + 1 (Mitte), gerade Eingaben paarweise darum
+      const float * z = buf_ + ((2 * m + 2 * kPairs - 1) << 2);
+      float32x4_t acc = vmulq_n_f32(vld1q_f32(z), 0.5f);
+      for (size_t i = 0; i < kPairs; ++i) {
+        const float32x4_t pair = vaddq_f32(vld1q_f32(z + ((2 * i + 1) << 2)), vld1q_f32(z - ((2 * i + 1) << 2)));
+        acc = vmlaq_n_f32(acc, pair, coeffs_[i]);
+      }
+      vst1q_f32(dst + (m << 2), acc);
+    }
+    std::memmove(buf_, buf_ + (in_frames << 2), (k_history << 2) * sizeof(float));
+  }
+
+private:
+  const float * coeffs_;
+  float * buf_;  // [Vorgeschichte | Block]
+};
@@ -0,0 +1,182 @@
+#pragma once
+/*
+ *  File: perf.h
+ *
+ *  Optional CPU load meter for the render callback (KICK_PERF_STATS).
+ *  Uses the ARMv7 PMU cycle counter when user access is enabled, a
+ *  monotonic clock otherwise. Tracks min, max and EMA load per block
+ *  relative to the real-time budget, plus xrun-risk counts.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#include "unit.h"  // fast_inline
+
+#ifndef KICK_PERF_CPU_HZ
+#define KICK_PERF_CPU_HZ 1000000000u  // CPU-Takt für die Umrechnung der CCNT-Zyklen
+#endif
+
+static constexpr float k_perf_ema_coeff = 1.f / 64.f;
+static constexpr float k_perf_risk_load = 0.75f;  // Block braucht mehr als 75% seines Budgets
+
+// Anzeigen des CPU-LOAD-Parameters
+enum {
+  k_perf_view_avg = 0,  // EMA der Last
+  k_perf_view_max,
+  k_perf_view_min,
+  k_perf_view_risk,     // Blöcke über k_perf_risk_load
+  k_perf_view_xrun,     // Blöcke über 100%
+  k_perf_view_cost,     // Zyklen bzw. ns pro Frame (EMA)
+  k_num_perf_views
+};
+
+class PerfMeter {
+public:
+  PerfMeter(void) {
+    Init(48000.f);
+  }
+
+  void Init(float samplerate) {
+    use_ccnt_ = ccntAvailable();
+    tick_cycles_ = 1;
+    float sec_per_tick = 1e-9f;
+#if defined(__arm__) && !defined(KICK_NEON_EMULATED)
+    if (use_ccnt_) {
+      // PMCR.D: Zähler läuft nur alle 64 Zyklen
+      uint32_t pmcr;
+      __asm__ volatile("mrc p15, 0, %0, c9, c12, 0" : "=r"(pmcr));
+      tick_cycles_ = (pmcr & 0x8u) ? 64u : 1u;
+      sec_per_tick = static_cast<float>(tick_cycles_) / KICK_PERF_CPU_HZ;
+    }
+#endif
+    load_per_tick_ = sec_per_tick * samplerate;
+    Reset();
+  }
+
+  void Reset() {
+    min_ = 1e9f;
+    max_ = 0.f;
+    ema_ = 0.f;
+    cost_ema_ = 0.f;
+    risk_ = 0;
+    xrun_ = 0;
+  }
+
+  fast_inline void Begin() {
+    start_ = now();
+  }
+
+  fast_inline void End(size_t frames) {
+    if (frames == 0) return;
+    const uint32_t ticks = now() - start_;  // 32-Bit-Differenz, überlauffest
+    const float per_frame = static_cast<float>(ticks) / frames;
+    const float load = per_frame * load_per_tick_;
+    if (load < min_) min_ = load;
+    if (load > max_) max_ = load;
+    ema_ += (load - ema_) * k_perf_ema_coeff;
+    cost_ema_ += (per_frame * tick_cycles_ - cost_ema_) * k_perf_ema_coeff;
+    if (load > k_perf_risk_load) ++risk_;
+    if (load > 1.f) ++xrun_;
+  }
+
+  // Text für den Parameter; Werte werden vom Audio-Thread geschrieben und
+  // hier ohne Synchronisation gelesen, fürs Display genügt das
+  const char * Format(int32_t view) {
+    switch (view) {
+      case k_perf_view_max:
+        return formatLoad("MAX ", max_);
+      case k_perf_view_min:
+        return formatLoad("MIN ", min_ > max_ ? 0.f : min_);
+      case k_perf_view_risk:
+        return formatCount("RISK ", risk_);
+      case k_perf_view_xrun:
+        return formatCount("XRUN ", xrun_);
+      case k_perf_view_cost:
+        return formatCount(use_ccnt_ ? "CYC " : "NS ", static_cast<uint32_t>(cost_ema_ + 0.5f));
+      case k_perf_view_avg:
+      default:
+        return formatLoad("AVG ", ema_);
+    }
+  }
+
+private:
+  static bool ccntAvailable() {
+#if defined(__arm__) && !defined(KICK_NEON_EMULATED)
+    // PMUSERENR ist in PL0 immer lesbar; CCNT nur, wenn EN gesetzt ist und
+    // der Kernel den Zähler freigegeben hat (PMCNTENSET Bit 31)
+    uint32_t user_enable;
+    __asm__ volatile("mrc p15, 0, %0, c9, c14, 0" : "=r"(user_enable));
+    if (!(user_enable & 1u)) return false;
+    uint32_t count_enable;
+    __asm__ volatile("mrc p15, 0, %0, c9, c12, 1" : "=r"(count_enable));
+    return (count_enable & 0x80000000u) != 0;
+#else
+    return false;
+#endif
+  }
+
+  fast_inline uint32_t now() const {
+#if defined(__arm__) && !defined(KICK_NEON_EMULATED)
+    if (use_ccnt_) {
+      uint32_t cycles;
+      __asm__ volatile("mrc p15, 0, %0, c9, c13, 0" : "=r"(cycles));
+      return cycles;
+    }
+#endif
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint32_t>(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+  }
+
+  // "AVG 12.3%", Last mit einer Nachkommastelle
+  const char * formatLoad(const char * label, float load) {
+    uint32_t permille = static_cast<uint32_t>(load * 1000.f + 0.5f);
+    if (permille > 99999u) permille = 99999u;
+    char * p = appendLabel(label);
+    p = appendUint(p, permille / 10u);
+    *p++ = '.';
+    *p++ = static_cast<char>('0' + permille % 10u);
+    *p++ = '%';
+    *p = '\0';
+    return text_;
+  }
+
+  const char * formatCount(const char * label, uint32_t count) {
+    *appendUint(appendLabel(label), count) = '\0';
+    return text_;
+  }
+
+  char * appendLabel(const char * label) {
+    char * p = text_;
+    while (*label) *p++ = *label++;
+    return p;
+  }
+
+  static char * appendUint(char * p, uint32_t value) {
+    char digits[10];
+    size_t n = 0;
+    do {
+      digits[n++] = static_cast<char>('0' + value % 10u);
+      value /= 10u;
+    } while (value > 0);
+    while (n > 0) *p++ = digits[--n];
+    return p;
+  }
+
+  uint32_t start_;
+  bool use_ccnt_;
+  uint32_t tick_cycles_;      // Zyklen pro Tick (CCNT), im Clock-Betrieb 1 ns
+  float load_per_tick_;       // Tick pro Frame -> Anteil am Echtzeitbudget
+  float min_;
+  float max_;
+  float ema_;
+  float cost_ema_;
+  uint32_t risk_;
+  uint32_t xrun_;
+  char text_[24];
+};
@@ -0,0 +1,109 @@
+#pragma once
+/*
+ *  File: preset.h
+ *
+ *  Packed preset format and preset bank. A preset is one 64-byte POD
+ *  record holding the parameters in their header.c integer units plus
+ *  the sine tier and oversampling factor. The bank indexes the factory
+ *  table (read-only, in the binary) followed by a fixed number of user
+ *  slots, so looking up any preset is O(1) and loading it is one memcpy.
+ *  The loaded record reaches the render thread through a triple buffer,
+ *  so the bank can be changed at any time.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+static constexpr size_t k_preset_num_params = 24;  // = Synth::k_num_params
+static constexpr size_t k_preset_name_len = 14;    // Mit abschließender Null
+
+struct KickPreset {
+  char name[k_preset_name_len];
+  int16_t params[k_preset_num_params];  // Parameter-Einheiten wie header.c, Reihenfolge wie k_param_*
+  uint8_t sine_tier;                    // k_sine_*
+  uint8_t os_factor;                    // k_os_*
+};
+
+static_assert(sizeof(KickPreset) == 64, "Ein Preset pro Cache-Line");
+
+// kFactory Werkspresets gefolgt von kUser Benutzer-Slots, Index wie
+// unit_load_preset. Gehört dem UI-Thread
+template <size_t kFactory, size_t kUser>
+class PresetBank {
+  static_assert(kUser <= 32, "used_ ist eine 32-Bit-Maske");
+  static_assert(kFactory + kUser <= 256, "Preset-Index ist uint8_t");
+
+public:
+  static constexpr size_t k_num_slots = kFactory + kUser;
+
+  explicit PresetBank(const KickPreset * factory) : factory_(factory), used_(0) {}
+
+  // nullptr für leere Benutzer-Slots und Indizes außerhalb der Bank
+  inline const KickPreset * Find(size_t index) const {
+    if (index < kFactory) return factory_ + index;
+    const size_t slot = index - kFactory;
+    return slot < kUser && (used_ & (1u << slot)) ? &user_[slot] : nullptr;
+  }
+
+  // slot zählt ab dem ersten Benutzer-Slot
+  inline bool Store(size_t slot, const KickPreset & preset) {
+    if (slot >= kUser) return false;
+    std::memcpy(&user_[slot], &preset, sizeof(KickPreset));
+    user_[slot].name[k_preset_name_len - 1] = '\0';
+    used_ |= 1u << slot;
+    return true;
+  }
+
+  inline void Clear(size_t slot) {
+    if (slot < kUser) used_ &= ~(1u << slot);
+  }
+
+private:
+  const KickPreset * factory_;  // kFactory Einträge
+  KickPreset user_[kUser];
+  uint32_t used_;  // Bit s = Benutzer-Slot s belegt
+};
+
+// Übergabe des zuletzt geladenen Presets vom UI- an den Render-Thread als
+// Dreifachpuffer: Jede Seite besitzt einen Puffer, der dritte liegt in der
+// Mitte. Publish() beschreibt den eigenen und tauscht ihn gegen den
+// mittleren, Take() tauscht den eigenen gegen den mittleren, falls dort ein
+// neuer liegt. Der Render-Thread liest also nie einen Puffer, den die UI
+// gerade beschreibt, auch nicht bei mehreren Ladevorgängen pro Block
+class PresetHandoff {
+public:
+  PresetHandoff(void) : middle_(1), ui_(0), render_(2) {
+    std::memset(slots_, 0, sizeof(slots_));
+  }
+
+  // Nur vom UI-Thread aufrufen
+  inline void Publish(const KickPreset & preset) {
+    std::memcpy(&slots_[ui_], &preset, sizeof(KickPreset));
+    ui_ = middle_.exchange(ui_ | k_fresh, std::memory_order_acq_rel) & k_index_mask;
+  }
+
+  // Nur vom Render-Thread aufrufen: das zuletzt veröffentlichte Preset,
+  // gültig bis zum nächsten Take()
+  inline const KickPreset * Take() {
+    if (middle_.load(std::memory_order_relaxed) & k_fresh) {
+      render_ = middle_.exchange(render_, std::memory_order_acq_rel) & k_index_mask;
+    }
+    return &slots_[render_];
+  }
+
+private:
+  enum {
+    k_index_mask = 3,
+    k_fresh = 4  // Mittlerer Puffer noch nicht abgeholt
+  };
+
+  KickPreset slots_[3];
+  std::atomic<uint8_t> middle_;  // Index | k_fresh
+  uint8_t ui_;                   // Gehört dem UI-Thread
+  uint8_t render_;               // Gehört dem Render-Thread
+};
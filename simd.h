@@ -0,0 +1,68 @@
+#pragma once
+/*
+ *  File: simd.h
+ *
+ *  NEON helpers shared by the block renderer.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+
+#include <arm_neon.h>
+
+#include "unit.h"  // fast_inline
+
+// Inklusive Präfixsumme über die 4 Lanes: [a, a+b, a+b+c, a+b+c+d]
+fast_inline float32x4_t vprefixsum_f32(float32x4_t x) {
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  x = vaddq_f32(x, vextq_f32(zero, x, 3));
+  x = vaddq_f32(x, vextq_f32(zero, x, 2));
+  return x;
+}
+
+// floor() für moderate Beträge (|x| < 2^31), ARMv7 hat kein vrndmq_f32
+fast_inline float32x4_t vfloor_f32(float32x4_t x) {
+  const float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(x));
+  const uint32x4_t gt = vcgtq_f32(t, x);
+  return vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(gt, vreinterpretq_u32_f32(vdupq_n_f32(1.f)))));
+}
+
+// Nachkommaanteil, Ergebnis in [0, 1)
+fast_inline float32x4_t vfrac_f32(float32x4_t x) {
+  return vsubq_f32(x, vfloor_f32(x));
+}
+
+// 1 / x mit Schätzung und zwei Newton-Schritten (ARMv7 hat kein vdivq_f32)
+fast_inline float32x4_t vrecip_f32(float32x4_t x) {
+  float32x4_t r = vrecpeq_f32(x);
+  r = vmulq_f32(r, vrecpsq_f32(x, r));
+  r = vmulq_f32(r, vrecpsq_f32(x, r));
+  return r;
+}
+
+// Letzte Lane in alle Lanes kopieren (bleibt im NEON-Registersatz)
+fast_inline float32x4_t vduplast_f32(float32x4_t x) {
+  return vdupq_lane_f32(vget_high_f32(x), 1);
+}
+
+// Vorgänger je Lane: [prev[3], x[0], x[1], x[2]]
+fast_inline float32x4_t vshiftin_f32(float32x4_t prev, float32x4_t x) {
+  return vextq_f32(prev, x, 3);
+}
+
+// dst[i] = start + (i + 1) * inc für i < len
+fast_inline void vramp_f32(float * __restrict dst, float start, float inc, size_t len) {
+  static const float s_steps[4] = {1.f, 2.f, 3.f, 4.f};
+  float32x4_t v = vmlaq_n_f32(vdupq_n_f32(start), vld1q_f32(s_steps), inc);
+  const float32x4_t step = vdupq_n_f32(4.f * inc);
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    vst1q_f32(dst + i, v);
+    v = vaddq_f32(v, step);
+  }
+  for (; i < len; ++i) {
+    dst[i] = start + (i + 1) * inc;
+  }
+}
@@ -0,0 +1,115 @@
+#pragma once
+/*
+ *  File: smooth.h
+ *
+ *  Linear parameter smoothing at block rate. Every parameter glides to a
+ *  new target over a fixed number of frames; a bitmask tracks the ones
+ *  still moving, so parameters at rest cost nothing per block. The value
+ *  type is float, or int32_t for the fixed-point kernel, where the step
+ *  is an integer division and the ramp is exact on every target.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+template <size_t kCount, typename T = float>
+class ParamSmoother {
+  static_assert(kCount <= 32, "Die Maske der bewegten Parameter hat 32 Bit");
+
+public:
+  ParamSmoother(void) : moving_(0), ramp_frames_(0), inv_ramp_frames_(0.f) {
+    for (size_t id = 0; id < kCount; ++id) {
+      value_[id] = target_[id] = step_[id] = 0;
+      remaining_[id] = 0;
+    }
+  }
+
+  // Rampenlänge in Frames, 0 = neue Ziele werden sofort übernommen
+  inline void Init(uint32_t ramp_frames) {
+    ramp_frames_ = ramp_frames;
+    inv_ramp_frames_ = ramp_frames > 0 ? 1.f / ramp_frames : 0.f;
+  }
+
+  // Neues Ziel; die Rampe startet beim aktuellen Wert
+  inline void Set(size_t id, T target) {
+    if (target == target_[id]) return;
+    target_[id] = target;
+    if (ramp_frames_ == 0 || target == value_[id]) {
+      value_[id] = target;
+      moving_ &= ~bit(id);
+      return;
+    }
+    step_[id] = step(target - value_[id]);
+    remaining_[id] = ramp_frames_;
+    moving_ |= bit(id);
+  }
+
+  // Alle Rampen sofort ans Ziel setzen
+  inline void Settle() {
+    for (uint32_t mask = moving_; mask != 0; mask &= mask - 1) {
+      const size_t id = __builtin_ctz(mask);
+      value_[id] = target_[id];
+    }
+    moving_ = 0;
+  }
+
+  // Schaltet alle bewegten Parameter um frames weiter. Rückgabe: Maske der
+  // Parameter, deren Wert sich in diesem Block geändert hat
+  inline uint32_t Advance(uint32_t frames) {
+    const uint32_t moved = moving_;
+    for (uint32_t mask = moved; mask != 0; mask &= mask - 1) {
+      const size_t id = __builtin_ctz(mask);
+      if (remaining_[id] <= frames) {
+        value_[id] = target_[id];  // exakt am Ziel enden
+        moving_ &= ~bit(id);
+      } else {
+        value_[id] += step_[id] * static_cast<T>(frames);
+        remaining_[id] -= frames;
+      }
+    }
+    return moved;
+  }
+
+  inline uint32_t Moving() const {
+    return moving_;
+  }
+
+  inline T Value(size_t id) const {
+    return value_[id];
+  }
+
+  inline T Target(size_t id) const {
+    return target_[id];
+  }
+
+  // Aktuelle Werte, Index = Parameter-ID
+  inline const T * Values() const {
+    return value_;
+  }
+
+private:
+  static inline uint32_t bit(size_t id) {
+    return 1u << id;
+  }
+
+  // Änderung pro Frame; ganzzahlig zur Null gerundet, Advance() endet
+  // trotzdem exakt am Ziel
+  inline float step(float diff) const {
+    return diff * inv_ramp_frames_;
+  }
+
+  inline int32_t step(int32_t diff) const {
+    return diff / static_cast<int32_t>(ramp_frames_);
+  }
+
+  T value_[kCount];
+  T target_[kCount];
+  T step_[kCount];              // Änderung pro Frame
+  uint32_t remaining_[kCount];  // Frames bis zum Ziel
+  uint32_t moving_;             // Bit id: Parameter id läuft noch
+  uint32_t ramp_frames_;
+  float inv_ramp_frames_;
+};
@@ -0,0 +1,70 @@
+#pragma once
+/*
+ *  File: spread.h
+ *
+ *  Transient-only stereo spread. The click and OSC2 components of the
+ *  voice sum are fed through a short Haas delay and added to the left and
+ *  subtracted from the right channel. The mono sum (L + R) and thus the
+ *  body of the kick stay untouched. Samples are float, or Q27 int32_t
+ *  with a Q31 width for the fixed-point kernel.
+ *
+ *  2023 (c) Your Name
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Ringpuffer mit kRingFrames Samples (Zweierpotenz) für eine Verzögerung
+// von kDelayFrames. Die Verzögerung ist mindestens so lang wie ein Block,
+// Process() liest also nie, was derselbe Aufruf schreibt. Den Speicher
+// (k_storage_samples) übergibt Init().
+template <size_t kRingFrames, size_t kDelayFrames, size_t kMaxBlock, typename T = float>
+class StereoSpread {
+  static_assert((kRingFrames & (kRingFrames - 1)) == 0, "Maske statt Modulo");
+  static_assert(kDelayFrames >= kMaxBlock && kDelayFrames + kMaxBlock <= kRingFrames, "Ring zu klein");
+
+public:
+  typedef T Sample;
+
+  static constexpr size_t k_storage_samples = kRingFrames;
+
+  StereoSpread(void) : ring_(nullptr), pos_(0) {}
+
+  inline void Init(T * storage) {
+    ring_ = storage;
+    Reset();
+  }
+
+  inline void Reset() {
+    std::memset(ring_, 0, kRingFrames * sizeof(T));
+    pos_ = 0;
+  }
+
+  // side[i] = width * in[i - kDelayFrames], in-place erlaubt
+  template <typename W>
+  inline void Process(T * side, const T * in, W width, size_t frames) {
+    static constexpr size_t k_mask = kRingFrames - 1;
+    for (size_t i = 0; i < frames; ++i) {
+      const size_t w = (pos_ + i) & k_mask;
+      const T x = in[i];
+      side[i] = scale(ring_[(w - kDelayFrames) & k_mask], width);
+      ring_[w] = x;
+    }
+    pos_ = (pos_ + frames) & k_mask;
+  }
+
+private:
+  static inline float scale(float x, float width) {
+    return width * x;
+  }
+
+  // Q27 * Q31 -> Q27, width < 1
+  static inline int32_t scale(int32_t x, int32_t width) {
+    return static_cast<int32_t>((static_cast<int64_t>(x) * width + (1ll << 30)) >> 31);
+  }
+
+  T * ring_;  // k_storage_samples
+  size_t pos_;    // Schreibposition des nächsten Frames
+};
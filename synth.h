@@ -13,15 +13,62 @@
 #include <cstdint>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 
 #include <arm_neon.h>
 
 #include "unit.h"  // Note: Include common definitions for all units
+#include "simd.h"
+#include "sine.h"
+#include "noise.h"
+#include "osc.h"
+#include "event_queue.h"
+#include "smooth.h"
+#include "oversample.h"
+#include "saturate.h"
+#include "filter.h"
+#include "envelope.h"
+#include "click_cache.h"
+#include "freeze.h"
+#include "spread.h"
+#include "lfo.h"
+#include "preset.h"
+#ifdef KICK_FIXED_POINT
+#include "fixed.h"
+#endif
+#include "arena.h"
+#ifdef KICK_PERF_STATS
+#include "perf.h"
+#endif
 
 // Konstanten definieren
 static constexpr float k_pi = 3.14159265358979323846f;
 static constexpr float k_twopi = 2.0f * k_pi;
 static constexpr float k_samplerate = 48000.0f; // Drumlogue samplerate
+static constexpr uint32_t k_samplerate_hz = 48000;  // Dieselbe, für ganzzahlige Ableitungen (LFO, Festkomma)
+static constexpr float k_inv_samplerate = 1.0f / k_samplerate;
+static constexpr size_t k_block_size = 64;       // Maximale Blocklänge des Block-Renderers (Vielfaches von 4)
+static constexpr size_t k_num_voices = 4;        // Stimmen im Pool, eine NEON-Lane pro Stimme
+static constexpr size_t k_event_queue_size = 64; // Parameter-Ereignisse UI -> Render-Thread
+static constexpr size_t k_note_queue_size = 64;  // Noten und Tempo -> Render-Thread
+static constexpr size_t k_click_cache_slots = 5;  // Vorberechnete Click-Transienten (4 Stimmen + 1 frei)
+static constexpr size_t k_click_max_frames = 4800; // 100 ms, längster CLICK DCY
+static constexpr size_t k_hit_max_frames = 51200;  // Freeze-Aufnahme, > ATTACK + RELEASE (1.05 s)
+static constexpr size_t k_spread_delay_frames = 288;  // Haas-Verzögerung der Stereo-Breite (6 ms)
+static constexpr size_t k_spread_ring_frames = 512;   // > Verzögerung + Block, Zweierpotenz
+static constexpr float k_lfo_pitch_octaves = 1.f;     // Pitch-Hub des LFO bei voller Tiefe
+static constexpr float k_lfo_amount_range = 0.5f;     // Cutoff-/Drive-Hub bei voller Tiefe (0 .. 1)
+static constexpr size_t k_memory_budget = 512 * 1024; // Obergrenze für alle Puffer der Unit (Bytes)
+static constexpr uint32_t k_smooth_frames = 480;  // Glättung kontinuierlicher Parameter (10 ms)
+
+static_assert(k_num_voices == 4, "Der Renderer verarbeitet alle Stimmen in einem float32x4_t");
+
+// Stimmenklau, wenn alle Stimmen belegt sind
+enum {
+  k_steal_oldest = 0,   // Am längsten klingende Stimme
+  k_steal_quietest,     // Stimme mit der kleinsten Amplitude (Envelope * Velocity)
+  k_num_steal_modes
+};
 
 // Wellenformen für den zweiten Oszillator
 enum {
@@ -34,8 +81,8 @@ enum {
 };
 
 // Hilfsfunktionen für die Wellenformerzeugung
-inline float waveformSine(float phase) {
-  return std::sin(phase * k_twopi);
+inline float waveformSine(float phase, uint8_t tier = k_sine_poly7) {
+  return sineTier(tier, phase);
 }
 
 inline float waveformSaw(float phase) {
@@ -51,10 +98,6 @@ inline float waveformPulse(float phase, float width = 0.5f) {
   return phase < width ? 1.0f : -1.0f;
 }
 
-inline float waveformNoise() {
-  return ((std::rand() & 0xFFFF) / 32768.0f) * 2.0f - 1.0f;
-}
-
 // Wellenform-Namen
 static const char * const s_waveform_names[k_num_waves] = {
   "Sine",
@@ -98,24 +141,38 @@ static const uint8_t s_bitmaps[k_num_waves][32] = {
   }
 };
 
-// Preset-Namen
-static const char * const s_preset_names[] = {
-  "Basic",
-  "Punchy",
-  "Sub Bass",
-  "FM Kick",
-  "Noise Attack"
+// LFO-Einstellungen (k_param_lfo): Ziel und Periode
+static const char * const s_lfo_names[] = {
+  "Off",
+  "Pit 1/16", "Pit 1/8", "Pit 1/4", "Pit 1/2", "Pit 1bar", "Pit 2bar",
+  "Cut 1/16", "Cut 1/8", "Cut 1/4", "Cut 1/2", "Cut 1bar", "Cut 2bar",
+  "Drv 1/16", "Drv 1/8", "Drv 1/4", "Drv 1/2", "Drv 1bar", "Drv 2bar",
 };
 
 class Synth {
 public:
+  // Zahlenformate des Kernels; mit KICK_FIXED_POINT ganzzahlig (fixed.h)
+#ifdef KICK_FIXED_POINT
+  typedef int32_t Sample;       // Audio Q27
+  typedef int32_t Param;        // Geglättete Parameter in Header-Einheiten, Q16
+  typedef int32_t Coeff;        // Format je k_ramp_*, siehe deriveCoefficients()
+  typedef EnvSegmentQ Segment;
+#else
+  typedef float Sample;
+  typedef float Param;
+  typedef float Coeff;
+  typedef EnvSegment Segment;
+#endif
+
   /*===========================================================================*/
   /* Lifecycle Methods. */
   /*===========================================================================*/
 
-  Synth(void) {
-    reset();
-    initParams();
+  Synth(void)
+      : os_up1_(k_hb_2x_c), os_down1_(k_hb_2x_c), os_up2_(k_hb_4x_c), os_down2_(k_hb_4x_c),
+        presets_(factoryPresets()) {
+    layoutArena();  // Vor reset(), das schon auf die Puffer zugreift
+    initialize();
   }
   
   ~Synth(void) {}
@@ -129,8 +186,13 @@ public:
     if (desc->output_channels != 2)  // should be stereo output
       return k_unit_err_geometry;
 
-    reset();
-    initParams();
+    // Direkt nach dem Konstruktor (Laden der Unit) ist der Zustand schon
+    // der Anfangszustand, nur ein benutztes Objekt wird neu initialisiert
+    if (!controls_.pristine) initialize();
+    controls_.pristine = false;
+#ifdef KICK_PERF_STATS
+    perf_.Init(static_cast<float>(desc->samplerate));
+#endif
     return k_unit_err_none;
   }
 
@@ -138,8 +200,9 @@ public:
     // Cleanup is not needed
   }
 
-  inline void Reset() {
-    reset();
+  // Setzt den Klangzustand zurück; der Seed macht die Noise-Folgen reproduzierbar
+  inline void Reset(uint32_t seed = k_noise_default_seed) {
+    reset(seed);
   }
 
   inline void Resume() {
@@ -154,399 +217,496 @@ public:
   /* Core Synth Methods. */
   /*===========================================================================*/
 
-  void reset() {
-    phase1_ = 0.f;
-    phase2_ = 0.f;
-    click_phase_ = 0.f;    // Neue Phase für Click-Oszillator
-    envelope_ = 0.f;
-    envelope_state_ = k_state_off;
-    pitch_envelope_ = 0.f;
-    osc2_envelope_ = 0.f;
-    current_note_ = 0;
-    current_velocity_ = 0.f;
-    
-    // Filter Reset
-    filter_enabled_ = false;
-    filter_mode_24db_ = false;
-    for (int i = 0; i < 4; ++i) {
-      filter_state_[i] = 0.0f;
-    }
+  // Einziger Initialisierungspfad für Konstruktor und Init(). Alle Tabellen
+  // (Sinus, tanh, Filter, Halbband, Presets) sind constexpr und liegen in
+  // .rodata, hier wird nur Zustand gesetzt
+  void initialize() {
+    reset();
+    initParams();
+    controls_.pristine = true;
+  }
+
+  void reset(uint32_t seed = k_noise_default_seed) {
+    // Alle Stimmen aus (k_state_off), Phasen, Envelopes und Filter auf 0
+    std::memset(voices_, 0, sizeof(Voices));
+    controls_.note_counter = 0;
     
-    last_noise_ = 0.f;
-    click_envelope_ = 0.f;
+    // Getrennte Noise-Folgen für OSC2 und Click, je eine Lane pro Stimme
+    osc2_noise_.Seed(seed);
+    controls_.click_seed = seed ^ 0x9E3779B9u;
+    render_.click_pending = 0;
+    render_.frozen_voices = 0;
+    hit_cache_.Invalidate();
+    resetOversampling();
+#ifdef KICK_SPREAD
+    spread_.Reset();
+#endif
+    render_.spread_live = false;
+    lfo_.Reset();  // Sonst hinge die Modulation davon ab, wie lange vorher gerendert wurde
   }
 
+  // Läuft vor dem ersten Render() (Konstruktor, Init), daher direkt angewendet
   void initParams() {
-    // Standardwerte setzen
-    pitch_ = 55.f;            // Etwas tiefer für mehr Fülle
-    decay_ = 130.f;
-    click_level_ = 0.5f;
-    pitch_curve_ = 0.5f;
-    body_level_ = 0.9f;
-    drive_ = 0.4f;
-    attack_ = 2.f;
-    release_ = 300.f;
-    
-    // Zweiter Oszillator Parameter
-    osc2_enabled_ = 1;
-    osc2_waveform_ = k_wave_sine;
-    osc2_pitch_ = 2.0f;
-    osc2_level_ = 0.5f;
-    fm_amount_ = 0.0f;
-    fm_ratio_ = 2.0f;
-    osc2_decay_ = 100.f;
-    pulse_width_ = 0.5f;
-    
-    // Neue Click Parameter
-    click_freq_ = 200.f;      // Frequenz des Click-Oscillators (Hz)
-    click_decay_ = 20.f;      // Decay-Zeit des Clicks (ms)
-    click_tone_ = 0.6f;       // Toncharakter - 0 = rauschmäßig, 1 = tonal
+    // Standardwerte in Parameter-Einheiten, Reihenfolge wie k_param_*
+    static const int32_t s_defaults[k_num_params] = {
+      55, 130, 90, 40,   // Pitch (etwas tiefer für mehr Fülle), Decay, Body, Drive
+      2, 300, 50, 0,     // Attack, Release, Pitch-Kurve, LFO aus
+      50, 200, 20, 60,   // Click: Level, Frequenz (Hz), Decay (ms), Ton (0 = rauschmäßig, 100 = tonal)
+      0, 70, 20, 0,      // Filter aus, Cutoff 70%, moderate Resonanz, 12dB/Okt
+      1, k_wave_sine, 20, 50,  // OSC2 an, Wellenform, Tonhöhe x2.0, Level
+      0, 20, 100, k_slot_23_default,  // FM Amount, FM Ratio x2.0, OSC2 Decay, LFO-Tiefe / CPU-Last-Anzeige
+    };
+    lfo_.Init(k_samplerate_hz);
+    lfo_.SetTempo(k_lfo_default_tempo);
+    ui_tempo_.store(k_lfo_default_tempo, std::memory_order_relaxed);
+    render_.lfo_depth = k_lfo_depth_default / 100.f;  // Mit KICK_PERF_STATS nicht einstellbar
+#ifdef KICK_FIXED_POINT
+    render_.lfo_depth_q = pctQ31(k_lfo_depth_default << 16);
+#endif
+    smoother_.Init(k_smooth_frames);
+    for (uint8_t id = 0; id < k_num_params; ++id) {
+      ui_params_[id].store(s_defaults[id], std::memory_order_relaxed);
+      applyParameter(id, s_defaults[id]);
+    }
+    smoother_.Settle();  // Startwerte ohne Rampe
+    render_.pulse_width = 0.5f;
+#ifdef KICK_FIXED_POINT
+    render_.pulse_width_q = 0x80000000u;  // 0.5, Q32
+#endif
     
-    // Neue Filter Parameter
-    filter_enabled_ = false;  // Filter standardmäßig aus
-    filter_cutoff_ = 0.7f;    // Anfangsfrequenz 70%
-    filter_resonance_ = 0.2f; // Moderate Resonanz
-    filter_mode_24db_ = false;// Standard 12dB/Okt
+    render_.sine_tier = k_sine_poly7;
+    ui_sine_tier_.store(render_.sine_tier, std::memory_order_relaxed);
+    render_.os_factor = k_os_1x;
+    ui_os_factor_.store(render_.os_factor, std::memory_order_relaxed);
+    controls_.freeze_enabled = false;
+    ui_freeze_.store(0, std::memory_order_relaxed);
+    render_.spread_width = 0.f;
+#ifdef KICK_FIXED_POINT
+    render_.spread_width_q = 0;
+#endif
+    ui_spread_.store(0, std::memory_order_relaxed);
+    controls_.polyphony = k_num_voices;
+    ui_polyphony_.store(controls_.polyphony, std::memory_order_relaxed);
+    controls_.steal_mode = k_steal_quietest;
+    ui_steal_mode_.store(controls_.steal_mode, std::memory_order_relaxed);
     
-    preset_index_ = 0;
-    last_noise_ = 0.f;
-    click_envelope_ = 0.f;
+    controls_.preset_index = 0;
+    flags_.store(0, std::memory_order_relaxed);
+#ifdef KICK_NOTE_OFFSETS
+    schedule_head_ = 0;
+    schedule_count_ = 0;
+#endif
+    render_.coeffs_dirty = true;
+  }
+
+  // Sinus-Kernel wählen (k_sine_*, siehe sine.h); LoadPreset setzt ihn pro Preset
+  inline void setSineTier(uint8_t tier) {
+    const uint8_t valid = tier < k_num_sine_tiers ? tier : static_cast<uint8_t>(k_sine_poly7);
+    ui_sine_tier_.store(valid, std::memory_order_relaxed);
+    postEvent(k_event_sine_tier, valid);
+  }
+
+  inline uint8_t getSineTier() const {
+    return static_cast<uint8_t>(ui_sine_tier_.load(std::memory_order_relaxed));
+  }
+
+  // Oversampling der Drive-Stufe (k_os_*, siehe oversample.h); LoadPreset
+  // setzt es pro Preset
+  inline void setOversampling(uint8_t factor) {
+    const uint8_t valid = factor < k_num_os_factors ? factor : static_cast<uint8_t>(k_os_1x);
+    ui_os_factor_.store(valid, std::memory_order_relaxed);
+    postEvent(k_event_oversampling, valid);
+  }
+
+  inline uint8_t getOversampling() const {
+    return static_cast<uint8_t>(ui_os_factor_.load(std::memory_order_relaxed));
+  }
+
+#ifdef KICK_FREEZE
+  // Freeze-Modus: der erste Treffer bei ruhenden Parametern wird mitgeschnitten,
+  // weitere Treffer spielen nur noch die Aufnahme mit ihrer Velocity ab. Jede
+  // Parameteränderung verwirft die Aufnahme, der nächste Treffer nimmt neu auf.
+  // Nur mit KICK_FREEZE (config.mk), die Unit hat keinen Weg dorthin
+  inline void setFreeze(bool enabled) {
+    ui_freeze_.store(enabled ? 1 : 0, std::memory_order_relaxed);
+    postEvent(k_event_freeze, enabled ? 1 : 0);
   }
 
+  inline bool getFreeze() const {
+    return ui_freeze_.load(std::memory_order_relaxed) != 0;
+  }
+#endif
+
+#ifdef KICK_SPREAD
+  // Stereo-Breite nur für Click und OSC2 (0 .. 100 %), der Körper bleibt
+  // mono. Wirkt nur auf Render(), RenderMono() bleibt unverändert.
+  // Nur mit KICK_SPREAD (config.mk), die Unit hat keinen Weg dorthin
+  inline void setSpread(uint8_t amount) {
+    const uint8_t valid = amount > 100 ? 100 : amount;
+    ui_spread_.store(valid, std::memory_order_relaxed);
+    postEvent(k_event_spread, valid);
+  }
+
+  inline uint8_t getSpread() const {
+    return static_cast<uint8_t>(ui_spread_.load(std::memory_order_relaxed));
+  }
+#endif
+
+  // Anzahl gleichzeitig klingender Stimmen (1 .. k_num_voices), 1 entspricht
+  // dem früheren Mono-Verhalten. Stimmen darüber klingen noch zu Ende.
+  // allocateVoice() liest den Wert im Render-Thread, daher über die Queue
+  inline void setPolyphony(uint8_t voices) {
+    const uint8_t valid = voices < 1 ? 1 : (voices > k_num_voices ? static_cast<uint8_t>(k_num_voices) : voices);
+    ui_polyphony_.store(valid, std::memory_order_relaxed);
+    postEvent(k_event_polyphony, valid);
+  }
+
+  inline uint8_t getPolyphony() const {
+    return static_cast<uint8_t>(ui_polyphony_.load(std::memory_order_relaxed));
+  }
+
+  // k_steal_oldest oder k_steal_quietest, wie die Polyphonie über die Queue
+  inline void setVoiceStealMode(uint8_t mode) {
+    const uint8_t valid = mode < k_num_steal_modes ? mode : static_cast<uint8_t>(k_steal_quietest);
+    ui_steal_mode_.store(valid, std::memory_order_relaxed);
+    postEvent(k_event_steal_mode, valid);
+  }
+
+  inline uint8_t getVoiceStealMode() const {
+    return static_cast<uint8_t>(ui_steal_mode_.load(std::memory_order_relaxed));
+  }
+
+  // Stereo, interleaved L/R (beide Kanäle identisch)
   fast_inline void Render(float * out, size_t frames) {
-    float * __restrict out_p = out;
-    const float * out_e = out_p + (frames << 1);  // assuming stereo output
+    renderFrames<2>(out, frames);
+  }
+
+  // Nur ein Kanal, für Hosts und Offline-Export ohne doppelten Store
+  fast_inline void RenderMono(float * out, size_t frames) {
+    renderFrames<1>(out, frames);
+  }
+
+  /*===========================================================================*/
+  /* Block Renderer. */
+  /*===========================================================================*/
 
-    for (; out_p != out_e; out_p += 2) {
-      float value = process();
-      out_p[0] = value;  // Left
-      out_p[1] = value;  // Right
+  // Die ganze Kette ist mono und endet in out_buf_; erst writeOutput()
+  // verteilt das Signal auf das Ausgangslayout, kChannels = 1 (mono) oder 2
+  // (interleaved, beide Kanäle gleich)
+  template <size_t kChannels>
+  fast_inline void renderFrames(float * out, size_t frames) {
+#ifdef KICK_PERF_STATS
+    perf_.Begin();
+    const size_t total_frames = frames;
+#endif
+    if (controls_.pristine) controls_.pristine = false;
+    // In Blöcke von höchstens k_block_size Frames zerlegen, mit
+    // KICK_NOTE_OFFSETS zusätzlich an jedem Ereignis-Offset; Ereignisse
+    // gelten ab dem Blockanfang
+    scheduleEvents();
+    size_t pos = 0;
+    while (pos < frames) {
+#ifdef KICK_NOTE_OFFSETS
+      size_t n = applyEvents(pos);
+#else
+      size_t n = k_block_size;
+#endif
+      if (n > frames - pos) n = frames - pos;
+      lfo_.Advance(n);  // Auch in Stille, das LFO hält das Tempo
+      float * __restrict out_p = out + pos * kChannels;
+      if (!anyVoiceActive()) {
+        // Ohne rechnende Stimme hängt der Ausgang nicht von den Parametern
+        // ab (Stille oder nur eingefrorene Stimmen), laufende Rampen dürfen
+        // daher sofort ans Ziel springen
+#ifdef KICK_FREEZE
+        if (render_.frozen_voices) {
+          mixFrozen(n);
+          writeOutput<kChannels>(out_p, freeze_buf_, n);
+        } else {
+          std::memset(out_p, 0, n * kChannels * sizeof(float));
+        }
+#else
+        std::memset(out_p, 0, n * kChannels * sizeof(float));
+#endif
+        if (smoother_.Moving()) {
+          smoother_.Settle();
+          render_.coeffs_dirty = true;
+        }
+#ifdef KICK_SPREAD
+        // Der Rest der Verzögerung ist nach dem Ausklang praktisch still
+        if (render_.spread_live) {
+          spread_.Reset();
+          render_.spread_live = false;
+        }
+#endif
+      } else {
+#ifdef KICK_SPREAD
+        const bool spread = kChannels == 2 && render_.spread_width > 0.f;
+        renderBlock(n, spread);
+        if (spread) {
+          writeSpread(out_p, n);
+        } else {
+          writeOutput<kChannels>(out_p, out_buf_, n);
+        }
+#else
+        renderBlock(n, false);
+        writeOutput<kChannels>(out_p, out_buf_, n);
+#endif
+      }
+      pos += n;
     }
+#ifdef KICK_NOTE_OFFSETS
+    carryEvents(frames);
+#endif
+#ifdef KICK_PERF_STATS
+    perf_.End(total_frames);
+#endif
   }
 
-  float process() {
-    float out = 0.f;
-    
-    // Envelope-Berechnung
-    switch (envelope_state_) {
-      case k_state_attack:
-        envelope_ += (1.f / (attack_ / 1000.f * k_samplerate));
-        if (envelope_ >= 1.f) {
-          envelope_ = 1.f;
-          envelope_state_ = k_state_decay;
+  // Rendert höchstens k_block_size Frames für alle Stimmen gleichzeitig: jede
+  // Stufe arbeitet auf Blockpuffern im Layout [Frame][Stimme], ein
+  // float32x4_t enthält also einen Frame aller vier Stimmen. Rekursionen
+  // (Envelopes, Phasen, Filter) laufen so über die Zeit und parallel über die
+  // Stimmen. Oszillator- und Shaping-Stufe sind pro Konfiguration
+  // spezialisierte Kernel (siehe selectKernels()). Ergebnis: Summe der
+  // Stimmen in out_buf_, Layout [Frame], vor dem Limiter. Mit spread
+  // zusätzlich Click und OSC2 verzögert in side_buf_ (siehe spread.h).
+  void renderBlock(size_t frames, bool spread) {
+    if (render_.coeffs_dirty) updateCoefficients();
+    advanceSmoothing(frames);
+#ifdef KICK_SPREAD
+    render_.spread_block = spread;
+#else
+    (void)spread;
+#endif
+
+    // --- Envelopes ---
+#ifdef KICK_FIXED_POINT
+    renderEnvelopesQ(frames);
+#else
+    renderEnvelopes(frames);
+#endif
+
+    // --- Phasen, Körper und OSC2 -> mix_buf_ ---
+    (this->*render_.osc_stage)(frames);
+
+    // --- Click: nur solange eine Stimme noch einen Transienten abspielt ---
+    if (render_.click_pending) resolveClicks();
+    if (anyClickActive()) {
+#ifdef KICK_FIXED_POINT
+      renderClickQ(frames);
+#else
+      renderClick(frames);
+#endif
+    }
+
+    // --- Drive und Filter ---
+    (this->*render_.shape_stage)(frames);
+
+    // --- Eingefrorene Stimmen -> freeze_buf_ ---
+#ifdef KICK_FREEZE
+    const Sample * frozen = render_.frozen_voices ? freeze_buf_ : nullptr;
+    if (frozen) mixFrozen(frames);
+#else
+    const Sample * frozen = nullptr;
+#endif
+
+    // --- Ausgangsverstärkung, Envelope, Summe der Stimmen -> out_buf_ ---
+#ifdef KICK_FIXED_POINT
+    sumVoicesQ(out_buf_, mix_q_, frozen, frames);
+#ifdef KICK_SPREAD
+    if (spread) {
+      sumVoicesQ(side_buf_, transient_buf_, nullptr, frames);
+      spread_.Process(side_buf_, side_buf_, render_.spread_width_q, frames);
+      render_.spread_live = true;
+    }
+#endif
+#else
+    {
+      float gain[k_num_voices];
+      for (size_t v = 0; v < k_num_voices; ++v) {
+        gain[v] = 1.3f * voices_->velocity[v];
+      }
+      size_t i = 0;
+      for (; i + 4 <= frames; i += 4) {
+        // 4 Frames x 4 Stimmen transponiert: val[v] = Stimme v über 4 Frames
+        const float32x4x4_t mix = vld4q_f32(mix_buf_ + (i << 2));
+        const float32x4x4_t env = vld4q_f32(env_buf_ + (i << 2));
+        float32x4_t x = vmulq_n_f32(vmulq_f32(mix.val[0], env.val[0]), gain[0]);
+        x = vmlaq_n_f32(x, vmulq_f32(mix.val[1], env.val[1]), gain[1]);
+        x = vmlaq_n_f32(x, vmulq_f32(mix.val[2], env.val[2]), gain[2]);
+        x = vmlaq_n_f32(x, vmulq_f32(mix.val[3], env.val[3]), gain[3]);
+        if (frozen) x = vaddq_f32(x, vld1q_f32(frozen + i));
+        vst1q_f32(out_buf_ + i, x);
+      }
+      for (; i < frames; ++i) {
+        float x = frozen ? frozen[i] : 0.f;
+        for (size_t v = 0; v < k_num_voices; ++v) {
+          x += mix_buf_[(i << 2) + v] * env_buf_[(i << 2) + v] * gain[v];
         }
-        break;
-        
-      case k_state_decay:
-        envelope_ -= (1.f / (release_ / 1000.f * k_samplerate));
-        if (envelope_ <= 0.f) {
-          envelope_ = 0.f;
-          envelope_state_ = k_state_off;
+        out_buf_[i] = x;
+      }
+
+#ifdef KICK_SPREAD
+      // --- Stereo-Breite: Click und OSC2 mit derselben Verstärkung -> side_buf_ ---
+      if (spread) {
+        for (i = 0; i + 4 <= frames; i += 4) {
+          const float32x4x4_t tr = vld4q_f32(transient_buf_ + (i << 2));
+          const float32x4x4_t env = vld4q_f32(env_buf_ + (i << 2));
+          float32x4_t x = vmulq_n_f32(vmulq_f32(tr.val[0], env.val[0]), gain[0]);
+          x = vmlaq_n_f32(x, vmulq_f32(tr.val[1], env.val[1]), gain[1]);
+          x = vmlaq_n_f32(x, vmulq_f32(tr.val[2], env.val[2]), gain[2]);
+          x = vmlaq_n_f32(x, vmulq_f32(tr.val[3], env.val[3]), gain[3]);
+          vst1q_f32(side_buf_ + i, x);
         }
-        break;
-        
-      case k_state_release:
-        envelope_ -= (1.f / (release_ / 1000.f * k_samplerate));
-        if (envelope_ <= 0.f) {
-          envelope_ = 0.f;
-          envelope_state_ = k_state_off;
+        for (; i < frames; ++i) {
+          float x = 0.f;
+          for (size_t v = 0; v < k_num_voices; ++v) {
+            x += transient_buf_[(i << 2) + v] * env_buf_[(i << 2) + v] * gain[v];
+          }
+          side_buf_[i] = x;
         }
-        break;
-        
-      case k_state_off:
-      default:
-        break;
+        spread_.Process(side_buf_, side_buf_, render_.spread_width, frames);
+        render_.spread_live = true;
+      }
+#endif
     }
-    
-    // Pitch-Envelope berechnen
-    if (envelope_state_ != k_state_off) {
-      pitch_envelope_ -= (1.f / (decay_ / 1000.f * k_samplerate));
-      if (pitch_envelope_ < 0.f) pitch_envelope_ = 0.f;
-      
-      // OSC2 Envelope separat berechnen
-      osc2_envelope_ -= (1.f / (osc2_decay_ / 1000.f * k_samplerate));
-      if (osc2_envelope_ < 0.f) osc2_envelope_ = 0.f;
-      
-      // Click Envelope separat berechnen
-      click_envelope_ -= (1.f / (click_decay_ / 1000.f * k_samplerate));
-      if (click_envelope_ < 0.f) click_envelope_ = 0.f;
+#endif
+
+#ifdef KICK_FREEZE
+    // --- Freeze: Aufnahme-Stimme vor Velocity und Limiter mitschneiden ---
+    if (hit_cache_.Recording()) recordHit(frames);
+#endif
+  }
+
+  // Ausgangsadapter: Limiter auf das Mono-Signal src (Layout [Frame]), dann
+  // ein Store pro 4 Frames ins Ausgangslayout. Einzige Stelle, die das
+  // Layout kennt; eine Stereo-Nachstufe setzt hier an
+  template <size_t kChannels>
+  void writeOutput(float * __restrict out, const Sample * __restrict src, size_t frames) {
+#ifdef KICK_FIXED_POINT
+    // Begrenzt in Q27, erst der Store wandelt (exakt gerundet) nach float
+    const int32x4_t lo = vdupq_n_s32(-(1 << k_q_audio_bits));
+    const int32x4_t hi = vdupq_n_s32(1 << k_q_audio_bits);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+      const int32x4_t x = vminq_s32(vmaxq_s32(vld1q_s32(src + i), lo), hi);
+      storeOutput<kChannels>(out + i * kChannels, vcvtq_n_f32_s32(x, k_q_audio_bits));
     }
-    
-    // Aktuelle Tonhöhe basierend auf Pitch-Envelope berechnen
-    float current_pitch = pitch_ * (1.f - pitch_envelope_ * pitch_curve_);
-    float freq1 = current_pitch;
-    
-    // Oszillator 2 Tonhöhe berechnen
-    float freq2 = current_pitch * osc2_pitch_;
-    
-    // *** Frequenzmodulation (FM) berechnen ***
-    float fm_mod = 0.f;
-    if (osc2_enabled_ && fm_amount_ > 0.f) {
-      // Phasenberechnung für den Modulationsoszillator
-      float mod_phase = phase2_;
-      
-      // Wellenform für FM
-      float mod_wave = waveformSine(mod_phase); // Sine funktioniert am besten für FM
-      
-      // FM-Betrag mit Envelope skalieren
-      fm_mod = mod_wave * fm_amount_ * osc2_envelope_ * 100.f; // Skalierungsfaktor für deutliche FM
+    for (; i < frames; ++i) {
+      const int32x4_t x = vminq_s32(vmaxq_s32(vdupq_n_s32(src[i]), lo), hi);
+      storeOutput<kChannels>(out + i * kChannels, vgetq_lane_f32(vcvtq_n_f32_s32(x, k_q_audio_bits), 0));
     }
-    
-    // Haupt-Oszillator-Phase berechnen (mit möglicher FM)
-    phase1_ += (freq1 + fm_mod) / k_samplerate;
-    if (phase1_ >= 1.f) phase1_ -= 1.f;
-    
-    // Zweite Oszillator-Phase berechnen
-    phase2_ += freq2 * fm_ratio_ / k_samplerate;
-    if (phase2_ >= 1.f) phase2_ -= 1.f;
-    
-    // Click-Oszillator-Phase berechnen
-    click_phase_ += click_freq_ / k_samplerate;
-    if (click_phase_ >= 1.f) click_phase_ -= 1.f;
-    
-    // Oszillator 1 (Sinus für den Körper)
-    float body = waveformSine(phase1_) * body_level_;
-    
-    // Oszillator 2 (mit wählbarer Wellenform)
-    float osc2_out = 0.f;
-    if (osc2_enabled_) {
-      switch (osc2_waveform_) {
-        case k_wave_sine:
-          osc2_out = waveformSine(phase2_);
-          break;
-        case k_wave_saw:
-          osc2_out = waveformSaw(phase2_);
-          break;
-        case k_wave_triangle:
-          osc2_out = waveformTriangle(phase2_);
-          break;
-        case k_wave_pulse:
-          osc2_out = waveformPulse(phase2_, pulse_width_);
-          break;
-        case k_wave_noise:
-          osc2_out = waveformNoise();
-          break;
-        default:
-          osc2_out = waveformSine(phase2_);
-          break;
-      }
-      
-      // Envelope auf OSC2 anwenden
-      osc2_out *= osc2_level_ * osc2_envelope_;
+#else
+    const float32x4_t lo = vdupq_n_f32(-1.f);
+    const float32x4_t hi = vdupq_n_f32(1.f);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+      const float32x4_t x = vminq_f32(vmaxq_f32(vld1q_f32(src + i), lo), hi);
+      storeOutput<kChannels>(out + i * kChannels, x);
     }
-    
-    // --- VERBESSERTE CLICK-GENERATION mit einstellbarer Tonalität ---
-    float click = 0.f;
-    if (envelope_state_ != k_state_off && click_envelope_ > 0.f) {
-      // Noise-Komponente
-      float noise = waveformNoise();
-      
-      // Tonale Komponente (Sinus-Oszillator)
-      float tonal = std::sin(click_phase_ * k_twopi);
-      
-      // Mischung zwischen Noise und Tonal je nach click_tone_
-      float click_source = noise * (1.0f - click_tone_) + tonal * click_tone_;
-      
-      // Hochpassfilter für schärferen Click
-      float hp_click = click_source - last_noise_ * 0.7f;
-      last_noise_ = click_source;
-      
-      click = hp_click * click_level_ * click_envelope_ * 3.0f;
+    for (; i < frames; ++i) {
+      float x = src[i];
+      if (x > 1.0f) x = 1.0f;
+      if (x < -1.0f) x = -1.0f;
+      storeOutput<kChannels>(out + i * kChannels, x);
     }
-    
-    // Kombinieren von Body, OSC2 und Click
-    out = body + osc2_out + click;
-    
-    // Soft-Clipping (Drive/Distortion)
-    if (drive_ > 0.f) {
-      out *= 1.f + drive_ * 4.f;
-      out = std::tanh(out) * (1.f / (1.f + drive_ * 1.5f));
+#endif
+  }
+
+#ifdef KICK_SPREAD
+  // Stereo mit Breite: L = mid + side, R = mid - side, beide begrenzt
+  void writeSpread(float * __restrict out, size_t frames) {
+#ifdef KICK_FIXED_POINT
+    const int32x4_t lo = vdupq_n_s32(-(1 << k_q_audio_bits));
+    const int32x4_t hi = vdupq_n_s32(1 << k_q_audio_bits);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+      const int32x4_t mid = vld1q_s32(out_buf_ + i);
+      const int32x4_t side = vld1q_s32(side_buf_ + i);
+      float32x4x2_t lr;
+      lr.val[0] = vcvtq_n_f32_s32(vminq_s32(vmaxq_s32(vqaddq_s32(mid, side), lo), hi), k_q_audio_bits);
+      lr.val[1] = vcvtq_n_f32_s32(vminq_s32(vmaxq_s32(vqsubq_s32(mid, side), lo), hi), k_q_audio_bits);
+      vst2q_f32(out + (i << 1), lr);
     }
-    
-    // --- Filter anwenden, wenn aktiviert ---
-    if (filter_enabled_) {
-      float cutoff = filter_cutoff_ * 0.9f + 0.1f; // Min. 10% bis 100%
-      float resonance = filter_resonance_ * 0.98f;  // Skaliert bis knapp unter Selbstoszillation
-      
-      if (filter_mode_24db_) {
-        // 24dB/Oct-Filter (4-Pol)
-        float f = cutoff * 1.16f;
-        float fb = resonance * 4.f * (1.0f - 0.15f * f * f);
-        
-        float input = out;
-        input -= filter_state_[3] * fb;
-        input *= 0.35013f * f * f * f * f;
-        
-        filter_state_[0] = input + 0.3f * filter_state_[0];
-        filter_state_[1] = filter_state_[0] + 0.3f * filter_state_[1];
-        filter_state_[2] = filter_state_[1] + 0.3f * filter_state_[2];
-        filter_state_[3] = filter_state_[2] + 0.3f * filter_state_[3];
-        
-        out = filter_state_[3];
-      } else {
-        // 12dB/Oct-Filter (2-Pol)
-        float f = cutoff * 1.16f;
-        float fb = resonance * 2.5f * (1.0f - 0.2f * f * f);
-        
-        float input = out;
-        input -= filter_state_[1] * fb;
-        input *= 0.35013f * f * f;
-        
-        filter_state_[0] = input + 0.3f * filter_state_[0];
-        filter_state_[1] = filter_state_[0] + 0.3f * filter_state_[1];
-        
-        out = filter_state_[1];
-      }
+    for (; i < frames; ++i) {
+      const int32x4_t mid = vdupq_n_s32(out_buf_[i]);
+      const int32x4_t side = vdupq_n_s32(side_buf_[i]);
+      out[(i << 1)] = vgetq_lane_f32(vcvtq_n_f32_s32(vminq_s32(vmaxq_s32(vqaddq_s32(mid, side), lo), hi), k_q_audio_bits), 0);
+      out[(i << 1) + 1] = vgetq_lane_f32(vcvtq_n_f32_s32(vminq_s32(vmaxq_s32(vqsubq_s32(mid, side), lo), hi), k_q_audio_bits), 0);
     }
-    
-    // Verstärktes Signal (grundsätzlich lauter machen)
-    out *= 1.3f;
-    
-    // Envelope anwenden
-    out *= envelope_ * current_velocity_;
-    
-    // Hard-Limiting am Ende
-    if (out > 1.0f) out = 1.0f;
-    if (out < -1.0f) out = -1.0f;
-    
-    return out;
+#else
+    const float32x4_t lo = vdupq_n_f32(-1.f);
+    const float32x4_t hi = vdupq_n_f32(1.f);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+      const float32x4_t mid = vld1q_f32(out_buf_ + i);
+      const float32x4_t side = vld1q_f32(side_buf_ + i);
+      float32x4x2_t lr;
+      lr.val[0] = vminq_f32(vmaxq_f32(vaddq_f32(mid, side), lo), hi);
+      lr.val[1] = vminq_f32(vmaxq_f32(vsubq_f32(mid, side), lo), hi);
+      vst2q_f32(out + (i << 1), lr);
+    }
+    for (; i < frames; ++i) {
+      float l = out_buf_[i] + side_buf_[i];
+      float r = out_buf_[i] - side_buf_[i];
+      l = l > 1.0f ? 1.0f : (l < -1.0f ? -1.0f : l);
+      r = r > 1.0f ? 1.0f : (r < -1.0f ? -1.0f : r);
+      out[(i << 1)] = l;
+      out[(i << 1) + 1] = r;
+    }
+#endif
+  }
+#endif
+
+  // 4 Frames bzw. ein Frame in das Ausgangslayout: mono direkt, stereo mit
+  // dem gleichen Wert links und rechts
+  template <size_t kChannels>
+  static fast_inline void storeOutput(float * out, float32x4_t x) {
+    static_assert(kChannels == 1 || kChannels == 2, "mono oder stereo");
+    if (kChannels == 1) {
+      vst1q_f32(out, x);
+    } else {
+      float32x4x2_t lr;
+      lr.val[0] = x;
+      lr.val[1] = x;
+      vst2q_f32(out, lr);
+    }
+  }
+
+  template <size_t kChannels>
+  static fast_inline void storeOutput(float * out, float x) {
+    out[0] = x;                      // Left (mono)
+    if (kChannels == 2) out[1] = x;  // Right
   }
 
   /*===========================================================================*/
   /* Parameter Interface. */
   /*===========================================================================*/
 
+  // UI-Thread: Wert sofort für getParameterValue merken, im Render-Thread
+  // erst an der nächsten Blockgrenze übernehmen
   inline void setParameter(uint8_t index, int32_t value) {
-    switch (index) {
-      case k_param_pitch:
-        pitch_ = value;
-        break;
-      case k_param_decay:
-        decay_ = value;
-        break;
-      case k_param_body_level:
-        body_level_ = value / 100.f;
-        break;
-      case k_param_drive:
-        drive_ = value / 100.f;
-        break;
-      case k_param_attack:
-        attack_ = value;
-        break;
-      case k_param_release:
-        release_ = value;
-        break;
-      case k_param_pitch_curve:
-        pitch_curve_ = value / 100.f;
-        break;
-      // Click-Parameter (Neu)
-      case k_param_click_level:
-        click_level_ = value / 100.f;
-        break;
-      case k_param_click_freq:
-        click_freq_ = value;
-        break;
-      case k_param_click_decay:
-        click_decay_ = value;
-        break;
-      case k_param_click_tone:
-        click_tone_ = value / 100.f;
-        break;
-      // Filter-Parameter (Neu)
-      case k_param_filter_enabled:
-        filter_enabled_ = value > 0;
-        break;
-      case k_param_filter_cutoff:
-        filter_cutoff_ = value / 100.f;
-        break;
-      case k_param_filter_resonance:
-        filter_resonance_ = value / 100.f;
-        break;
-      case k_param_filter_mode:
-        filter_mode_24db_ = value > 0;
-        break;
-      // OSC2-Parameter
-      case k_param_osc2_enabled:
-        osc2_enabled_ = value;
-        break;
-      case k_param_osc2_waveform:
-        osc2_waveform_ = value;
-        break;
-      case k_param_osc2_pitch:
-        osc2_pitch_ = value / 10.f;
-        break;
-      case k_param_osc2_level:
-        osc2_level_ = value / 100.f;
-        break;
-      case k_param_fm_amount:
-        fm_amount_ = value / 100.f;
-        break;
-      case k_param_fm_ratio:
-        fm_ratio_ = value / 10.f;
-        break;
-      case k_param_osc2_decay:
-        osc2_decay_ = value;
-        break;
-      default:
-        break;
-    }
+    if (index >= k_num_params) return;
+    ui_params_[index].store(value, std::memory_order_relaxed);
+    postEvent(index, value);
   }
 
   inline int32_t getParameterValue(uint8_t index) const {
-    switch (index) {
-      case k_param_pitch:
-        return pitch_;
-      case k_param_decay:
-        return decay_;
-      case k_param_body_level:
-        return body_level_ * 100.f;
-      case k_param_drive:
-        return drive_ * 100.f;
-      case k_param_attack:
-        return attack_;
-      case k_param_release:
-        return release_;
-      case k_param_pitch_curve:
-        return pitch_curve_ * 100.f;
-      // Click-Parameter (Neu)
-      case k_param_click_level:
-        return click_level_ * 100.f;
-      case k_param_click_freq:
-        return click_freq_;
-      case k_param_click_decay:
-        return click_decay_;
-      case k_param_click_tone:
-        return click_tone_ * 100.f;
-      // Filter-Parameter (Neu)
-      case k_param_filter_enabled:
-        return filter_enabled_ ? 1 : 0;
-      case k_param_filter_cutoff:
-        return filter_cutoff_ * 100.f;
-      case k_param_filter_resonance:
-        return filter_resonance_ * 100.f;
-      case k_param_filter_mode:
-        return filter_mode_24db_ ? 1 : 0;
-      // OSC2-Parameter
-      case k_param_osc2_enabled:
-        return osc2_enabled_;
-      case k_param_osc2_waveform:
-        return osc2_waveform_;
-      case k_param_osc2_pitch:
-        return osc2_pitch_ * 10.f;
-      case k_param_osc2_level:
-        return osc2_level_ * 100.f;
-      case k_param_fm_amount:
-        return fm_amount_ * 100.f;
-      case k_param_fm_ratio:
-        return fm_ratio_ * 10.f;
-      case k_param_osc2_decay:
-        return osc2_decay_;
-      default:
-        return 0;
-    }
+    if (index >= k_num_params) return 0;
+    return ui_params_[index].load(std::memory_order_relaxed);
   }
 
   inline const char * getParameterStrValue(uint8_t index, int32_t value) const {
+#ifdef KICK_PERF_STATS
+    // CPU-Last, value wählt die Anzeige (k_perf_view_*)
+    if (index == k_param_perf) {
+      return perf_.Format(value);
+    }
+#endif
+    if (index == k_param_lfo) {
+      return value >= 0 && value < k_num_lfo_settings ? s_lfo_names[value] : "---";
+    }
     // String für Wellenform-Parameter zurückgeben
     if (index == k_param_osc2_waveform) {
       uint8_t wave_idx = (uint8_t)value;
@@ -572,39 +732,29 @@ public:
   /* MIDI Interface. */
   /*===========================================================================*/
 
+  // Anschläge laufen über die Noten-Queue und gelten ab dem Anfang des
+  // nächsten Render()-Aufrufs
   inline void NoteOn(uint8_t note, uint8_t velocity) {
-    current_note_ = note;
-    current_velocity_ = velocity / 127.f;
-    
-    // Envelope auf Attack-Phase setzen
-    envelope_state_ = k_state_attack;
-    envelope_ = 0.f;
-    pitch_envelope_ = 1.f;
-    osc2_envelope_ = 1.f;
-inline void NoteOn(uint8_t note, uint8_t velocity) {
-    current_note_ = note;
-    current_velocity_ = velocity / 127.f;
-    
-    // Envelope auf Attack-Phase setzen
-    envelope_state_ = k_state_attack;
-    envelope_ = 0.f;
-    pitch_envelope_ = 1.f;
-    osc2_envelope_ = 1.f;
-    click_envelope_ = 1.f;  // Click-Envelope zurücksetzen
-    
-    // Filter- und Click-Status zurücksetzen
-    last_noise_ = 0.f;
-    for (int i = 0; i < 4; ++i) {
-      filter_state_[i] = 0.0f;
-    }
+    postNote(k_event_note_on, note | (velocity << 8), 0);
   }
 
   inline void NoteOff(uint8_t note) {
-    if (note == current_note_ || note == 0xFF) {
-      envelope_state_ = k_state_release;
-    }
+    postNote(k_event_note_off, note, 0);
+  }
+
+#ifdef KICK_NOTE_OFFSETS
+  // Nur Host-Werkzeuge: Die Runtime liefert keinen Zeitstempel, die Unit
+  // baut ohne. offset: Frames ab Beginn des nächsten Render()-Aufrufs, dort
+  // teilt Render() den Block, der Anschlag ist also sampelgenau
+  inline void NoteOn(uint8_t note, uint8_t velocity, uint16_t offset) {
+    postNote(k_event_note_on, note | (velocity << 8), offset);
   }
 
+  inline void NoteOff(uint8_t note, uint16_t offset) {
+    postNote(k_event_note_off, note, offset);
+  }
+#endif
+
   inline void GateOn(uint8_t velocity) {
     NoteOn(0xFF, velocity);
   }
@@ -617,6 +767,16 @@ inline void NoteOn(uint8_t note, uint8_t velocity) {
     NoteOff(0xFF);
   }
 
+  // unit_set_tempo: 16.16 Festkomma in BPM, für das LFO
+  inline void SetTempo(uint32_t tempo) {
+    ui_tempo_.store(static_cast<int32_t>(tempo), std::memory_order_relaxed);
+    postTempo(static_cast<int32_t>(tempo));
+  }
+
+  inline uint32_t getTempo() const {
+    return static_cast<uint32_t>(ui_tempo_.load(std::memory_order_relaxed));
+  }
+
   inline void PitchBend(uint16_t bend) {
     // Nicht verwendet für Kickdrum
     (void)bend;
@@ -637,184 +797,108 @@ inline void NoteOn(uint8_t note, uint8_t velocity) {
   /* Preset Interface. */
   /*===========================================================================*/
 
+  // Das Preset wird als ein Ereignis übernommen, ein Block sieht also nie
+  // ein halb geladenes Preset. index: Werkspresets, danach die Benutzer-Slots
   inline void LoadPreset(uint8_t index) {
-    preset_index_ = index;
-    
-    switch (index) {
-      case k_preset_basic:
-        // Grundlegender Kick-Sound mit mehr Punch
-        pitch_ = 55.f;
-        decay_ = 130.f;
-        pitch_curve_ = 0.5f;
-        body_level_ = 0.9f;
-        drive_ = 0.4f;
-        attack_ = 3.f;
-        release_ = 300.f;
-        
-        // Click Parameter
-        click_level_ = 0.5f;
-        click_freq_ = 200.f;
-        click_decay_ = 20.f;
-        click_tone_ = 0.6f;
-        
-        // Filter Parameter
-        filter_enabled_ = false;
-        filter_cutoff_ = 0.7f;
-        filter_resonance_ = 0.2f;
-        filter_mode_24db_ = false;
-        
-        // Abgeschalteter OSC2 für reinen Grund-Kick
-        osc2_enabled_ = 0;
-        osc2_waveform_ = k_wave_sine;
-        osc2_pitch_ = 2.0f;
-        osc2_level_ = 0.0f;
-        fm_amount_ = 0.0f;
-        fm_ratio_ = 2.0f;
-        osc2_decay_ = 100.f;
-        break;
-        
-      case k_preset_punchy:
-        // Punchiger Kick-Sound mit mehr Knackigkeit
-        pitch_ = 70.f;
-        decay_ = 80.f;
-        pitch_curve_ = 0.7f;
-        body_level_ = 0.9f;
-        drive_ = 0.6f;
-        attack_ = 1.f;
-        release_ = 180.f;
-        
-        // Click Parameter
-        click_level_ = 0.8f;
-        click_freq_ = 250.f;
-        click_decay_ = 15.f;
-        click_tone_ = 0.5f;
-        
-        // Filter Parameter
-        filter_enabled_ = true;
-        filter_cutoff_ = 0.9f;
-        filter_resonance_ = 0.3f;
-        filter_mode_24db_ = false;
-        
-        osc2_enabled_ = 0;
-        osc2_waveform_ = k_wave_sine;
-        osc2_pitch_ = 2.0f;
-        osc2_level_ = 0.0f;
-        fm_amount_ = 0.0f;
-        fm_ratio_ = 2.0f;
-        osc2_decay_ = 100.f;
-        break;
-        
-      case k_preset_sub:
-        // Tiefer Sub-Bass Kick mit mehr Wärme
-        pitch_ = 45.f;
-        decay_ = 250.f;
-        pitch_curve_ = 0.3f;
-        body_level_ = 0.95f;
-        drive_ = 0.35f;
-        attack_ = 8.f;
-        release_ = 500.f;
-        
-        // Click Parameter
-        click_level_ = 0.3f;
-        click_freq_ = 180.f;
-        click_decay_ = 25.f;
-        click_tone_ = 0.7f;
-        
-        // Filter Parameter
-        filter_enabled_ = true;
-        filter_cutoff_ = 0.6f;
-        filter_resonance_ = 0.1f;
-        filter_mode_24db_ = true;
-        
-        osc2_enabled_ = 0;
-        osc2_waveform_ = k_wave_sine;
-        osc2_pitch_ = 2.0f;
-        osc2_level_ = 0.0f;
-        fm_amount_ = 0.0f;
-        fm_ratio_ = 2.0f;
-        osc2_decay_ = 100.f;
-        break;
+    const KickPreset * preset = presets_.Find(index);
+    if (!preset) return;  // Leerer Benutzer-Slot, das geladene Preset bleibt
+    controls_.preset_index = index;
 
-      case k_preset_fm_kick:
-        // FM-Kick mit zweitem Oszillator und komplexer Klangfarbe
-        pitch_ = 55.f;
-        decay_ = 180.f;
-        pitch_curve_ = 0.6f;
-        body_level_ = 0.7f;
-        drive_ = 0.5f;
-        attack_ = 3.f;
-        release_ = 250.f;
-        
-        // Click Parameter
-        click_level_ = 0.4f;
-        click_freq_ = 220.f;
-        click_decay_ = 18.f;
-        click_tone_ = 0.8f;
-        
-        // Filter Parameter
-        filter_enabled_ = true;
-        filter_cutoff_ = 0.85f;
-        filter_resonance_ = 0.4f;
-        filter_mode_24db_ = false;
-        
-        osc2_enabled_ = 1;
-        osc2_waveform_ = k_wave_sine;
-        osc2_pitch_ = 3.0f;
-        osc2_level_ = 0.6f;
-        fm_amount_ = 0.7f;
-        fm_ratio_ = 2.7f;
-        osc2_decay_ = 80.f;
-        break;
+    for (uint8_t id = 0; id < k_num_params; ++id) {
+#ifdef KICK_PERF_STATS
+      if (id == k_param_perf) continue;  // Die gewählte Anzeige bleibt
+#endif
+      ui_params_[id].store(preset->params[id], std::memory_order_relaxed);
+    }
+    ui_sine_tier_.store(preset->sine_tier, std::memory_order_relaxed);
+    ui_os_factor_.store(preset->os_factor, std::memory_order_relaxed);
+    preset_handoff_.Publish(*preset);
+    postEvent(k_event_preset, index);
+  }
 
-      case k_preset_noise_attack:
-        // Kick mit Noise-Attack und starkem Punch
-        pitch_ = 50.f;
-        decay_ = 200.f;
-        pitch_curve_ = 0.5f;
-        body_level_ = 0.85f;
-        drive_ = 0.4f;
-        attack_ = 2.f;
-        release_ = 280.f;
-        
-        // Click Parameter
-        click_level_ = 0.7f;
-        click_freq_ = 300.f;
-        click_decay_ = 12.f;
-        click_tone_ = 0.3f;
-        
-        // Filter Parameter
-        filter_enabled_ = true;
-        filter_cutoff_ = 0.95f;
-        filter_resonance_ = 0.3f;
-        filter_mode_24db_ = false;
-        
-        osc2_enabled_ = 1;
-        osc2_waveform_ = k_wave_noise;
-        osc2_pitch_ = 1.0f;
-        osc2_level_ = 0.7f;
-        fm_amount_ = 0.0f;
-        fm_ratio_ = 1.0f;
-        osc2_decay_ = 20.f;
-        break;
+  // UI-Thread: Benutzer-Slot slot (0 .. k_num_user_presets - 1) belegen,
+  // geladen wird er mit LoadPreset(k_num_presets + slot)
+  inline bool StoreUserPreset(uint8_t slot, const KickPreset & preset) {
+    return presets_.Store(slot, preset);
+  }
 
-      default:
-        break;
+  // UI-Thread: die aktuellen Einstellungen als Benutzer-Preset
+  bool SaveUserPreset(uint8_t slot, const char * name) {
+    KickPreset preset;
+    std::memset(&preset, 0, sizeof(preset));
+    std::strncpy(preset.name, name, k_preset_name_len - 1);
+    for (uint8_t id = 0; id < k_num_params; ++id) {
+      preset.params[id] = static_cast<int16_t>(ui_params_[id].load(std::memory_order_relaxed));
     }
+#ifdef KICK_PERF_STATS
+    // Slot 23 hält hier die gewählte Anzeige, keine Tiefe: Wie LoadPreset
+    // überspringen und die Tiefe des geladenen Presets behalten
+    const KickPreset * loaded = presets_.Find(controls_.preset_index);
+    preset.params[k_param_perf] = loaded ? loaded->params[k_param_lfo_depth]
+                                         : static_cast<int16_t>(k_lfo_depth_default);
+#endif
+    preset.sine_tier = static_cast<uint8_t>(ui_sine_tier_.load(std::memory_order_relaxed));
+    preset.os_factor = static_cast<uint8_t>(ui_os_factor_.load(std::memory_order_relaxed));
+    return presets_.Store(slot, preset);
+  }
+
+  inline void ClearUserPreset(uint8_t slot) {
+    presets_.Clear(slot);
   }
 
   inline uint8_t getPresetIndex() const {
-    return preset_index_;
+    return controls_.preset_index;
   }
 
   /*===========================================================================*/
   /* Static Members. */
   /*===========================================================================*/
 
-  static inline const char * getPresetName(uint8_t idx) {
-    if (idx < 5) {
-      return s_preset_names[idx];
+  inline const char * getPresetName(uint8_t idx) const {
+    const KickPreset * preset = presets_.Find(idx);
+    return preset ? preset->name : "---";
+  }
+
+  // Subsysteme in der Arena, für den Speicher-Report des Host-Harness
+  enum {
+    k_mem_voices = 0,      // Stimmenzustand
+    k_mem_block,           // Blockpuffer und Koeffizienten-Rampen
+    k_mem_oversampling,    // Halbband-Vorgeschichte und Puffer auf 2x/4x Rate
+    k_mem_click,           // Click-Cache
+    k_mem_freeze,          // Freeze-Aufnahme und ihr Mischpuffer, ohne KICK_FREEZE 0
+    k_mem_spread,          // Stereo-Breite: Transienten-Puffer und Verzögerung, ohne KICK_SPREAD 0
+    k_num_mem_regions
+  };
+
+  static inline const char * getMemoryRegionName(uint8_t region) {
+    static const char * s_names[k_num_mem_regions] = {
+      "voices", "block buffers", "oversampling", "click cache", "freeze", "stereo spread"
+    };
+    return region < k_num_mem_regions ? s_names[region] : "---";
+  }
+
+  // Bytes inkl. Ausrichtung der Slices
+  static inline size_t getMemoryUsage(uint8_t region) {
+    switch (region) {
+      case k_mem_voices:
+        return k_voices_bytes;
+      case k_mem_block:
+        return k_block_bytes;
+      case k_mem_oversampling:
+        return k_oversampling_bytes;
+      case k_mem_click:
+        return k_click_bytes;
+      case k_mem_freeze:
+        return k_freeze_bytes;
+      case k_mem_spread:
+        return k_spread_bytes;
+      default:
+        return 0;
     }
-    return "---";
+  }
+
+  static inline size_t getMemoryBudget() {
+    return k_memory_budget;
   }
 
 private:
@@ -831,6 +915,7 @@ private:
     k_param_attack,             // Anstiegszeit
     k_param_release,            // Ausklingzeit
     k_param_pitch_curve,        // Verlauf des Pitch-Envelopes
+    k_param_lfo,                // LFO: Ziel x Rate (k_lfo_setting_*), 0 = aus
     
     // Neue Click-Parameter
     k_param_click_level,        // Stärke des Anschlagsklicks
@@ -851,8 +936,37 @@ private:
     k_param_osc2_level,         // Lautstärke des zweiten Oszillators
     k_param_fm_amount,          // Stärke der Frequenzmodulation
     k_param_fm_ratio,           // Verhältnis der FM-Modulationsfrequenz
-    k_param_osc2_decay          // Separate Abklingzeit für den zweiten Oszillator
+    k_param_osc2_decay,         // Separate Abklingzeit für den zweiten Oszillator
+    k_param_lfo_depth,          // LFO-Tiefe; mit KICK_PERF_STATS zeigt der Slot die CPU-Last
+    k_num_params,
+#ifdef KICK_PERF_STATS
+    k_param_perf = k_param_lfo_depth,
+#endif
   };
+
+  // LFO-Tiefe nach Init() in Prozent. Mit KICK_PERF_STATS bleibt sie dabei,
+  // der Klang ist also in beiden Builds gleich
+  static constexpr int32_t k_lfo_depth_default = 50;
+
+  // Wert von Slot 23 nach Init(): LFO-Tiefe bzw. erste Anzeige der CPU-Last
+#ifdef KICK_PERF_STATS
+  static constexpr int32_t k_slot_23_default = k_perf_view_avg;
+#else
+  static constexpr int32_t k_slot_23_default = k_lfo_depth_default;
+#endif
+
+  // Ziele des LFO
+  enum {
+    k_lfo_off = 0,
+    k_lfo_pitch,
+    k_lfo_cutoff,
+    k_lfo_drive,
+    k_num_lfo_dests
+  };
+
+  // k_param_lfo: 0 = aus, sonst 1 + (Ziel - 1) * k_num_lfo_rates + k_lfo_rate_*
+  static constexpr int32_t k_num_lfo_settings = 1 + (k_num_lfo_dests - 1) * k_num_lfo_rates;
+  static_assert(sizeof(s_lfo_names) / sizeof(s_lfo_names[0]) == k_num_lfo_settings, "Ein Name pro Einstellung");
   
   // Preset-Indizes
   enum {
@@ -860,7 +974,30 @@ private:
     k_preset_punchy,
     k_preset_sub,
     k_preset_fm_kick,
-    k_preset_noise_attack
+    k_preset_noise_attack,
+    k_num_presets
+  };
+
+  static constexpr size_t k_num_user_presets = 16;  // Hinter den Werkspresets, Index k_num_presets + Slot
+  static_assert(k_num_params == k_preset_num_params, "KickPreset::params wie k_param_*");
+
+  // Ereignisse außer Parametern (Parameter-Ereignisse tragen den k_param_* Index)
+  enum {
+    k_event_preset = 0x80,  // value = Preset-Index, das Preset selbst in preset_handoff_
+    k_event_sine_tier,      // value = k_sine_*
+    k_event_oversampling,   // value = k_os_*
+    k_event_freeze,         // value = 0 / 1
+    k_event_spread,         // value = 0 .. 100
+    k_event_polyphony,      // value = 1 .. k_num_voices
+    k_event_steal_mode,     // value = k_steal_*
+    k_event_tempo,          // value = BPM, 16.16 Festkomma
+    k_event_note_on,        // value = Note | Velocity << 8
+    k_event_note_off        // value = Note (0xFF: alle)
+  };
+
+  // Bits in flags_
+  enum {
+    k_flag_resync = 1u << 0  // Queue war voll: alle UI-Werte neu übernehmen
   };
   
   enum {
@@ -870,52 +1007,1761 @@ private:
     k_state_release
   };
 
-  // Oszillator und Envelope Zustände
-  float phase1_;           // Phase des Hauptoszillators
-  float phase2_;           // Phase des zweiten Oszillators
-  float click_phase_;      // Phase des Click-Oszillators (neu)
-  float envelope_;         // Amplituden-Envelope
-  float pitch_envelope_;   // Pitch-Envelope für Oszillator 1
-  float osc2_envelope_;    // Separates Envelope für Oszillator 2
-  float click_envelope_;   // Separates Envelope für Click (neu)
-  int envelope_state_;
-  
-  uint8_t current_note_;
-  float current_velocity_;
-  uint8_t preset_index_;
-  
-  // Haupt-Parameter
-  float pitch_;
-  float decay_;
-  float pitch_curve_;
-  float body_level_;
-  float drive_;
-  float attack_;
-  float release_;
-  
-  // Click-Parameter (neu)
-  float click_level_;
-  float click_freq_;
-  float click_decay_;
-  float click_tone_;
-  float last_noise_;
-  
-  // Filter-Parameter (neu)
-  bool filter_enabled_;
-  float filter_cutoff_;
-  float filter_resonance_;
-  bool filter_mode_24db_;
-  float filter_state_[4];  // Für einen 4-Pol Filter (24dB/Okt)
-  
-  // Oszillator 2 Parameter
-  uint8_t osc2_enabled_;
-  uint8_t osc2_waveform_;
-  float osc2_pitch_;
-  float osc2_level_;
-  float fm_amount_;
-  float fm_ratio_;
-  float osc2_decay_;
-  float pulse_width_; // Pulsbreite für Pulse-Wellenform
-  
-  std::atomic_uint_fast32_t flags_;
+  // Filter-Konfigurationen der Shaping-Kernel
+  enum {
+    k_filter_off = 0,
+    k_filter_12db,
+    k_filter_24db
+  };
+
+  // Drive-Konfigurationen der Shaping-Kernel, k_drive_1x + k_os_*
+  enum {
+    k_drive_off = 0,
+    k_drive_1x,
+    k_drive_2x,
+    k_drive_4x
+  };
+
+  /*===========================================================================*/
+  /* Parameter Events. */
+  /*===========================================================================*/
+
+  struct ParamEvent {
+    uint8_t id;       // k_param_* oder k_event_*
+    uint16_t offset;  // Frames ab Beginn des nächsten Render()-Aufrufs, ohne KICK_NOTE_OFFSETS 0
+    int32_t value;
+  };
+
+  // Zwei SPSC-Queues, jede mit genau einem Producer-Thread:
+  //   events_: setParameter, LoadPreset und die set*-Methoden (UI-Thread)
+  //   notes_:  NoteOn/NoteOff, Gate*, AllNoteOff und SetTempo (Sequencer)
+  // Das SDK sagt nicht zu, dass die Runtime Noten und Tempo aus demselben
+  // Thread ruft wie die Parameter-Callbacks, daher die eigene Queue. Innerhalb
+  // einer Gruppe muss jeder Aufrufer denselben Thread benutzen; ein Host mit
+  // mehreren Threads pro Gruppe serialisiert seine Aufrufe selbst.
+  // Die eigene Queue hält außerdem Platz für Anschläge frei: Ein Schwall
+  // Parameteränderungen und ein Presetwechsel können keinen verdrängen.
+
+  // UI-Thread. Ist die Queue voll, übernimmt der Render-Thread stattdessen
+  // alle UI-Werte auf einmal
+  inline void postEvent(uint8_t id, int32_t value) {
+    const ParamEvent event = {id, 0, value};
+    if (!events_.Push(event)) {
+      flags_.fetch_or(k_flag_resync, std::memory_order_release);
+    }
+  }
+
+  // Sequencer-Thread. Anschläge lassen sich nicht aus UI-Werten
+  // wiederherstellen; erst bei mehr als k_note_queue_size Noten zwischen
+  // zwei Blöcken entfällt einer
+  inline void postNote(uint8_t id, int32_t value, uint16_t offset) {
+    const ParamEvent event = {id, offset, value};
+    notes_.Push(event);
+  }
+
+  // Sequencer-Thread. Das Tempo hat einen UI-Wert, bei voller Queue also
+  // wie postEvent der Abgleich
+  inline void postTempo(int32_t tempo) {
+    const ParamEvent event = {k_event_tempo, 0, tempo};
+    if (!notes_.Push(event)) {
+      flags_.fetch_or(k_flag_resync, std::memory_order_release);
+    }
+  }
+
+  // Render-Thread, zu Beginn von Render(): Mit KICK_NOTE_OFFSETS beide
+  // Queues in den Fahrplan übernehmen, nach Offset sortiert (gleiche Offsets
+  // erst events_, dann notes_, je in Aufrufreihenfolge), sonst alle
+  // Ereignisse sofort anwenden.
+  // Nach einem Überlauf ersetzt der Abgleich mit den UI-Werten alle übrigen
+  // Ereignisse: Sie sind älter als diese Werte (die UI schreibt den Wert vor
+  // dem Ereignis), also leeren die Schleifen die Queues ganz und behalten
+  // nur die Anschläge. Später angewandt würden sie den neuesten Stand
+  // überschreiben.
+  inline void scheduleEvents() {
+    const bool resync = (flags_.fetch_and(~static_cast<uint_fast32_t>(k_flag_resync),
+                                          std::memory_order_acquire) & k_flag_resync) != 0;
+    if (resync) {
+      for (uint8_t id = 0; id < k_num_params; ++id) {
+        applyParameter(id, ui_params_[id].load(std::memory_order_relaxed));
+      }
+      applySineTier(static_cast<uint8_t>(ui_sine_tier_.load(std::memory_order_relaxed)));
+      applyOversampling(static_cast<uint8_t>(ui_os_factor_.load(std::memory_order_relaxed)));
+      applyFreeze(ui_freeze_.load(std::memory_order_relaxed) != 0);
+#ifdef KICK_SPREAD
+      applySpread(static_cast<uint8_t>(ui_spread_.load(std::memory_order_relaxed)));
+#endif
+      controls_.polyphony = static_cast<uint8_t>(ui_polyphony_.load(std::memory_order_relaxed));
+      controls_.steal_mode = static_cast<uint8_t>(ui_steal_mode_.load(std::memory_order_relaxed));
+      lfo_.SetTempo(static_cast<uint32_t>(ui_tempo_.load(std::memory_order_relaxed)));
+    }
+    takeEvents(events_, resync);
+    takeEvents(notes_, resync);
+  }
+
+  template <typename Queue>
+  inline void takeEvents(Queue & queue, bool resync) {
+    ParamEvent event;
+#ifdef KICK_NOTE_OFFSETS
+    while ((resync || schedule_count_ < k_schedule_size) && queue.Pop(event)) {
+      if (resync && event.id != k_event_note_on && event.id != k_event_note_off) continue;
+      if (schedule_count_ == k_schedule_size) continue;  // Fahrplan voll, wie bei voller Queue
+      size_t i = schedule_count_++;
+      for (; i > 0 && schedule_[i - 1].offset > event.offset; --i) {
+        schedule_[i] = schedule_[i - 1];
+      }
+      schedule_[i] = event;
+    }
+#else
+    while (queue.Pop(event)) {
+      if (resync && event.id != k_event_note_on && event.id != k_event_note_off) continue;
+      applyEvent(event);
+    }
+#endif
+  }
+
+#ifdef KICK_NOTE_OFFSETS
+
+  // Übernimmt alle Ereignisse bis Frame pos; Rückgabe: Länge des nächsten
+  // Blocks, höchstens k_block_size und höchstens bis zum nächsten Ereignis
+  inline size_t applyEvents(size_t pos) {
+    while (schedule_head_ < schedule_count_ && schedule_[schedule_head_].offset <= pos) {
+      applyEvent(schedule_[schedule_head_++]);
+    }
+    if (schedule_head_ < schedule_count_) {
+      const size_t until = schedule_[schedule_head_].offset - pos;
+      return until < k_block_size ? until : k_block_size;
+    }
+    return k_block_size;
+  }
+
+  // Nach Render(): Übrige Ereignisse liegen hinter dem Block und zählen ab
+  // dem nächsten Aufruf
+  inline void carryEvents(size_t frames) {
+    size_t count = 0;
+    for (size_t i = schedule_head_; i < schedule_count_; ++i, ++count) {
+      schedule_[count] = schedule_[i];
+      schedule_[count].offset = static_cast<uint16_t>(schedule_[count].offset - frames);
+    }
+    schedule_head_ = 0;
+    schedule_count_ = static_cast<uint8_t>(count);
+  }
+#endif
+
+  inline void applyEvent(const ParamEvent & event) {
+    if (event.id < k_num_params) {
+      applyParameter(event.id, event.value);
+    } else if (event.id == k_event_preset) {
+      applyPreset();
+    } else if (event.id == k_event_sine_tier) {
+      applySineTier(static_cast<uint8_t>(event.value));
+    } else if (event.id == k_event_oversampling) {
+      applyOversampling(static_cast<uint8_t>(event.value));
+    } else if (event.id == k_event_freeze) {
+      applyFreeze(event.value != 0);
+#ifdef KICK_SPREAD
+    } else if (event.id == k_event_spread) {
+      applySpread(static_cast<uint8_t>(event.value));
+#endif
+    } else if (event.id == k_event_polyphony) {
+      controls_.polyphony = static_cast<uint8_t>(event.value);
+    } else if (event.id == k_event_steal_mode) {
+      controls_.steal_mode = static_cast<uint8_t>(event.value);
+    } else if (event.id == k_event_tempo) {
+      lfo_.SetTempo(static_cast<uint32_t>(event.value));  // Nur die Rate, Koeffizienten folgen blockweise
+    } else if (event.id == k_event_note_on) {
+      applyNoteOn(static_cast<uint8_t>(event.value), static_cast<uint8_t>(event.value >> 8));
+    } else if (event.id == k_event_note_off) {
+      applyNoteOff(static_cast<uint8_t>(event.value));
+    }
+  }
+
+  // Render-Thread: Anschlag zum Zeitpunkt des Ereignisses
+  void applyNoteOn(uint8_t note, uint8_t velocity) {
+    const size_t v = allocateVoice();
+    voices_->note[v] = note;
+#ifdef KICK_FIXED_POINT
+    voices_->gain_q[v] = static_cast<int32_t>(static_cast<int64_t>(q27(1.3)) * velocity / 127);
+#else
+    voices_->velocity[v] = velocity / 127.f;
+#endif
+    voices_->age[v] = ++controls_.note_counter;
+    if (hit_cache_.Recording() && v == render_.hit_voice) hit_cache_.Invalidate();  // Aufnahme geklaut
+    voices_->click_length[v] = 0;
+    render_.click_pending &= ~(1u << v);
+
+    // Freeze: die Stimme rechnet nicht mit, sondern spielt die Aufnahme ab
+    if (freezeActive() && hit_cache_.Valid()) {
+      voices_->state[v] = k_state_off;
+      voices_->frozen_pos[v] = 0;
+      render_.frozen_voices |= 1u << v;
+      return;
+    }
+    render_.frozen_voices &= ~(1u << v);
+    
+    // Envelope auf Attack-Phase setzen
+    voices_->state[v] = k_state_attack;
+    voices_->envelope[v] = 0.f;
+    voices_->pitch_envelope[v] = 1.f;
+    voices_->osc2_envelope[v] = 1.f;
+#ifdef KICK_FIXED_POINT
+    voices_->envelope_q[v] = 0;
+    voices_->pitch_envelope_q[v] = INT32_MAX;
+    voices_->osc2_envelope_q[v] = INT32_MAX;
+#endif
+    
+    // Filter nur für die neue Stimme zurücksetzen, die übrigen klingen
+    // ungestört aus. Der Click ist bei jedem Anschlag derselbe Transient und
+    // wird erst im nächsten Block aus dem Cache geholt (resolveClicks())
+    voices_->click_pos[v] = 0;
+    render_.click_pending |= 1u << v;
+    for (int i = 0; i < 4; ++i) {
+      voices_->filter_state[i][v] = 0.0f;
+#ifdef KICK_FIXED_POINT
+      voices_->filter_state_q[i][v] = 0;
+#endif
+    }
+
+    // Freeze: erster Treffer bei ruhenden Parametern wird aufgenommen. Die
+    // Aufnahme überschreibt den Speicher, also erst, wenn keine Stimme mehr
+    // die alte abspielt
+    if (freezeActive() && !hit_cache_.Recording() && render_.frozen_voices == 0 && !smoother_.Moving() &&
+        !lfoActive()) {
+      hit_cache_.Begin();
+      render_.hit_voice = static_cast<uint8_t>(v);
+    }
+  }
+
+  void applyNoteOff(uint8_t note) {
+    for (size_t v = 0; v < k_num_voices; ++v) {
+      if (voices_->state[v] != k_state_off && (note == voices_->note[v] || note == 0xFF)) {
+        // Release fällt wie Decay, nur ein Note-Off im Attack ändert den Treffer
+        if (voices_->state[v] == k_state_attack && hit_cache_.Recording() && v == render_.hit_voice) {
+          hit_cache_.Invalidate();
+        }
+        voices_->state[v] = k_state_release;
+      }
+    }
+  }
+
+  inline void applySineTier(uint8_t tier) {
+    if (tier == render_.sine_tier) return;
+    render_.sine_tier = tier;
+    hit_cache_.Invalidate();
+  }
+
+  // Die Aufnahme enthält nur das Mittensignal. Bei aktivem Spread wird
+  // daher weder aufgenommen noch abgespielt, sonst wäre nur der erste Treffer
+  // breit; die Aufnahme bleibt gültig, bis Spread wieder aus ist. Ohne
+  // KICK_FREEZE startet nie eine Aufnahme, hit_cache_ bleibt ohne Speicher
+  inline bool freezeActive() const {
+#ifdef KICK_FREEZE
+    return controls_.freeze_enabled && render_.spread_width == 0.f;
+#else
+    return false;
+#endif
+  }
+
+  // Ausschalten verwirft die Aufnahme, eingefrorene Stimmen klingen aus
+  inline void applyFreeze(bool enabled) {
+    controls_.freeze_enabled = enabled;
+    if (!enabled) hit_cache_.Invalidate();
+  }
+
+  // Füllt dieser Block transient_buf_ (Oszillator- und Click-Kernel); ohne
+  // KICK_SPREAD konstant, die Abzweigungen fallen dann weg
+  inline bool spreadBlock() const {
+#ifdef KICK_SPREAD
+    return render_.spread_block;
+#else
+    return false;
+#endif
+  }
+
+#ifdef KICK_SPREAD
+  // Beim Einschalten ohne Reste aus einer früheren Verwendung
+  inline void applySpread(uint8_t amount) {
+    const float width = amount * 0.01f;
+    if (render_.spread_width == 0.f && width > 0.f) {
+      spread_.Reset();
+      render_.spread_live = false;
+    }
+    render_.spread_width = width;
+#ifdef KICK_FIXED_POINT
+    render_.spread_width_q = pctQ31(amount << 16);
+#endif
+  }
+#endif
+
+  // Filterzustände gehören zum alten Faktor und werden beim Wechsel verworfen
+  inline void applyOversampling(uint8_t factor) {
+    if (factor == render_.os_factor) return;
+    render_.os_factor = factor;
+    resetOversampling();
+    hit_cache_.Invalidate();
+    render_.coeffs_dirty = true;
+  }
+
+  // Kontinuierlicher Parameter mit dem Wert value / divisor. Der
+  // Festkomma-Kernel glättet die Header-Einheiten selbst (Q16), den Teiler
+  // rechnen deriveCoefficients() und deriveEnvelopes() ganzzahlig mit
+  inline void setSmoothed(uint8_t id, int32_t value, int32_t divisor) {
+#ifdef KICK_FIXED_POINT
+    (void)divisor;
+    smoother_.Set(id, value << 16);
+#else
+    smoother_.Set(id, static_cast<float>(value) / divisor);
+#endif
+  }
+
+  // Übernimmt einen Parameter in den Klangzustand (nur im Render-Thread).
+  // Kontinuierliche Parameter laufen über den Smoother, schaltende direkt
+  void applyParameter(uint8_t index, int32_t value) {
+    switch (index) {
+      case k_param_pitch:
+        setSmoothed(k_param_pitch, value, 1);
+        break;
+      case k_param_decay:
+        setSmoothed(k_param_decay, value, 1);
+        break;
+      case k_param_body_level:
+        setSmoothed(k_param_body_level, value, 100);
+        break;
+      case k_param_drive:
+        setSmoothed(k_param_drive, value, 100);
+        break;
+      case k_param_attack:
+        setSmoothed(k_param_attack, value, 1);
+        break;
+      case k_param_release:
+        setSmoothed(k_param_release, value, 1);
+        break;
+      case k_param_pitch_curve:
+        setSmoothed(k_param_pitch_curve, value, 100);
+        break;
+      // Click-Parameter (Neu)
+      case k_param_click_level:
+        setSmoothed(k_param_click_level, value, 100);
+        break;
+      case k_param_click_freq:
+        setSmoothed(k_param_click_freq, value, 1);
+        break;
+      case k_param_click_decay:
+        setSmoothed(k_param_click_decay, value, 1);
+        break;
+      case k_param_click_tone:
+        setSmoothed(k_param_click_tone, value, 100);
+        break;
+      // Filter-Parameter (Neu)
+      case k_param_filter_enabled:
+        controls_.filter_enabled = value > 0;
+        break;
+      case k_param_filter_cutoff:
+        setSmoothed(k_param_filter_cutoff, value, 100);
+        break;
+      case k_param_filter_resonance:
+        setSmoothed(k_param_filter_resonance, value, 100);
+        break;
+      case k_param_filter_mode:
+        render_.filter_mode_24db = value > 0;
+        break;
+      // OSC2-Parameter
+      case k_param_osc2_enabled:
+        controls_.osc2_enabled = value;
+        break;
+      case k_param_osc2_waveform:
+        controls_.osc2_waveform = value;
+        break;
+      case k_param_osc2_pitch:
+        setSmoothed(k_param_osc2_pitch, value, 10);
+        break;
+      case k_param_osc2_level:
+        setSmoothed(k_param_osc2_level, value, 100);
+        break;
+      case k_param_fm_amount:
+        setSmoothed(k_param_fm_amount, value, 100);
+        break;
+      case k_param_fm_ratio:
+        setSmoothed(k_param_fm_ratio, value, 10);
+        break;
+      case k_param_osc2_decay:
+        setSmoothed(k_param_osc2_decay, value, 1);
+        break;
+      case k_param_lfo:
+        if (value <= 0 || value >= k_num_lfo_settings) {
+          render_.lfo_dest = k_lfo_off;
+        } else {
+          render_.lfo_dest = static_cast<uint8_t>(k_lfo_pitch + (value - 1) / k_num_lfo_rates);
+          lfo_.SetRate(static_cast<uint8_t>((value - 1) % k_num_lfo_rates));
+        }
+        break;
+      case k_param_lfo_depth:
+#ifdef KICK_PERF_STATS
+        return;  // Nur Anzeige, Koeffizienten und Freeze-Aufnahme bleiben gültig
+#else
+        render_.lfo_depth = value / 100.f;
+#ifdef KICK_FIXED_POINT
+        render_.lfo_depth_q = pctQ31(value << 16);
+#endif
+        break;
+#endif
+      default:
+        break;
+    }
+    render_.coeffs_dirty = true;
+    hit_cache_.Invalidate();
+  }
+
+  // Übernimmt das zuletzt geladene Preset, danach laufen die Werte wie
+  // einzelne Parameter durch Glättung und Koeffizienten. Stehen mehrere
+  // Ladevorgänge in der Queue, gilt jedes Mal der neueste; so überschreibt
+  // ein dazwischen gesetzter älterer Parameterwert ihn nicht
+  void applyPreset() {
+    const KickPreset & preset = *preset_handoff_.Take();
+    for (uint8_t id = 0; id < k_num_params; ++id) {
+      applyParameter(id, preset.params[id]);
+    }
+    applySineTier(preset.sine_tier);
+    applyOversampling(preset.os_factor);
+  }
+
+  // Werkspresets in Parameter-Einheiten, Reihenfolge wie k_param_*.
+  // Sinus-Kernel: poly7 für die tiefen bzw. FM-lastigen Presets, 2x
+  // Oversampling für kräftigen Drive bzw. FM-Obertöne. Slot 23 (LFO-Tiefe)
+  // bleibt mit KICK_PERF_STATS beim Laden unberührt
+  static const KickPreset * factoryPresets() {
+    static constexpr KickPreset s_presets[k_num_presets] = {
+      // Basic: grundlegender Kick-Sound mit mehr Punch, OSC2 aus für reinen Grund-Kick
+      {"Basic",
+       {55, 130, 90, 40, 3, 300, 50, 0,
+        50, 200, 20, 60,
+        0, 70, 20, 0,
+        0, k_wave_sine, 20, 0, 0, 20, 100, 50},
+       k_sine_poly5, k_os_1x},
+      // Punchy: punchiger Kick-Sound mit mehr Knackigkeit
+      {"Punchy",
+       {70, 80, 90, 60, 1, 180, 70, 0,
+        80, 250, 15, 50,
+        1, 90, 30, 0,
+        0, k_wave_sine, 20, 0, 0, 20, 100, 50},
+       k_sine_poly5, k_os_2x},
+      // Sub Bass: tiefer Sub-Bass Kick mit mehr Wärme
+      {"Sub Bass",
+       {45, 250, 95, 35, 8, 500, 30, 0,
+        30, 180, 25, 70,
+        1, 60, 10, 1,
+        0, k_wave_sine, 20, 0, 0, 20, 100, 50},
+       k_sine_poly7, k_os_1x},
+      // FM Kick: FM-Kick mit zweitem Oszillator und komplexer Klangfarbe
+      {"FM Kick",
+       {55, 180, 70, 50, 3, 250, 60, 0,
+        40, 220, 18, 80,
+        1, 85, 40, 0,
+        1, k_wave_sine, 30, 60, 70, 27, 80, 50},
+       k_sine_poly7, k_os_2x},
+      // Noise Attack: Kick mit Noise-Attack und starkem Punch
+      {"Noise Attack",
+       {50, 200, 85, 40, 2, 280, 50, 0,
+        70, 300, 12, 30,
+        1, 95, 30, 0,
+        1, k_wave_noise, 10, 70, 0, 10, 20, 50},
+       k_sine_poly5, k_os_1x},
+    };
+    return s_presets;
+  }
+
+  /*===========================================================================*/
+  /* Derived Coefficients. */
+  /*===========================================================================*/
+
+  // Koeffizienten, die pro Sample wirken und bei Parameteränderungen als
+  // Rampe über den Block laufen (ramp_buf_)
+  enum {
+    k_ramp_pitch = 0,    // Grundton (Hz)
+    k_ramp_pitch_depth,  // Pitch-Envelope-Hub (Hz)
+    k_ramp_osc2_inc,     // Phaseninkrement OSC2 pro Hz Grundton
+    k_ramp_fm_depth,     // FM-Hub in Hz bei voller OSC2-Envelope
+    k_ramp_body,
+    k_ramp_osc2_level,
+    k_ramp_click_gain,
+    k_ramp_drive_pre,
+    k_ramp_drive_post,
+    k_ramp_filter_g,     // Einpol-Faktor G = g / (1 + g) der TPT-Stufen
+    k_ramp_filter_k,     // Resonanz-Rückkopplung
+    k_ramp_filter_norm,  // 1 / (1 + k * G^Pole), löst die verzögerungsfreie Schleife
+    k_ramp_filter_comp,  // Eingangsverstärkung gegen den Pegelverlust durch k
+    k_num_ramps
+  };
+
+  // Aus den Parametern abgeleitete Werte, damit der Block-Renderer ohne
+  // Divisionen auskommt. Gelten für alle Stimmen gleichermaßen.
+  struct Coefficients {
+    Segment attack;   // Amp-Envelope
+    Segment release;  // Decay und Release der Amp-Envelope
+    Segment pitch;
+    Segment osc2;
+    Coeff ramp[k_num_ramps];  // k_ramp_*, Wert am Blockende
+  };
+
+  // Parameter der Envelope-Segmente (Bit = k_param_*)
+  static constexpr uint32_t k_env_params = (1u << k_param_attack) | (1u << k_param_release) |
+      (1u << k_param_decay) | (1u << k_param_osc2_decay);
+
+#ifdef KICK_FIXED_POINT
+  // Header-Einheiten (Q16) -> Q31 bzw. Phaseninkrement, ganzzahlig
+  static inline int32_t pctQ31(int32_t percent_q16) {
+    return sat32((static_cast<int64_t>(percent_q16) << 15) / 100);
+  }
+
+  static inline int32_t hzToInc(int32_t hz_q16) {
+    return static_cast<int32_t>((static_cast<int64_t>(hz_q16) << 16) / k_samplerate_hz);
+  }
+
+  // Wie unten, p in Header-Einheiten Q16, Segmente aus envAttackQ()/envDecayQ()
+  void deriveEnvelopes(const int32_t * p, Coefficients & c) const {
+    static constexpr uint32_t k_frames_per_ms = k_samplerate_hz / 1000;
+    c.attack = envAttackQ(static_cast<uint32_t>(p[k_param_attack]) * k_frames_per_ms);
+    c.release = envDecayQ(static_cast<uint32_t>(p[k_param_release]) * k_frames_per_ms);
+    c.pitch = envDecayQ(static_cast<uint32_t>(p[k_param_decay]) * k_frames_per_ms);
+    c.osc2 = envDecayQ(static_cast<uint32_t>(p[k_param_osc2_decay]) * k_frames_per_ms);
+  }
+
+  // Formate je k_ramp_*: Grundton, Pitch- und FM-Hub als Phaseninkrement
+  // Q32, OSC2-Frequenzverhältnis Q26, Body, OSC2-Pegel, Drive nach dem
+  // Saturator, G und norm Q31, Click-Pegel, Drive davor, k und comp Q27
+  void deriveCoefficients(const int32_t * p, Coefficients & c) const {
+    static constexpr int32_t k_percent_q16 = 100 << 16;
+    const int32_t inc = hzToInc(p[k_param_pitch]);
+    c.ramp[k_ramp_pitch] = inc;
+    c.ramp[k_ramp_pitch_depth] = static_cast<int32_t>(static_cast<int64_t>(inc) * p[k_param_pitch_curve] / k_percent_q16);
+    // Zehntel * Zehntel: / 100, Q32 -> Q26
+    c.ramp[k_ramp_osc2_inc] = static_cast<int32_t>(static_cast<int64_t>(p[k_param_osc2_pitch]) * p[k_param_fm_ratio] / (100 << 6));
+    c.ramp[k_ramp_fm_depth] = hzToInc(p[k_param_fm_amount]);  // 100% = 100 Hz
+    c.ramp[k_ramp_body] = pctQ31(p[k_param_body_level]);
+    c.ramp[k_ramp_osc2_level] = pctQ31(p[k_param_osc2_level]);
+    c.ramp[k_ramp_click_gain] = static_cast<int32_t>((static_cast<int64_t>(p[k_param_click_level]) * 3 << 11) / 100);
+    c.ramp[k_ramp_drive_pre] = q27(1.0) + static_cast<int32_t>((static_cast<int64_t>(p[k_param_drive]) * 4 << 11) / 100);
+    c.ramp[k_ramp_drive_post] = sat32((static_cast<int64_t>(k_percent_q16) << 31) / (k_percent_q16 + p[k_param_drive] * 3 / 2));
+
+    const int32_t g = filterGainQ31(p[k_param_filter_cutoff] / 100);
+    const int32_t k = static_cast<int32_t>((static_cast<int64_t>(p[k_param_filter_resonance]) * 38 << 11) / 1000);  // * 3.8
+    const int32_t g2 = qrdmulh(g, g);
+    const int32_t gp = render_.filter_mode_24db ? qrdmulh(g2, g2) : g2;
+    c.ramp[k_ramp_filter_g] = g;
+    c.ramp[k_ramp_filter_k] = k;
+    c.ramp[k_ramp_filter_norm] = sat32((1ll << 58) / (q27(1.0) + qrdmulh(k, gp)));
+    c.ramp[k_ramp_filter_comp] = q27(1.0) + k / 2;
+  }
+#else
+  // p: geglättete Parameter, Index = k_param_*. Die Segmente folgen der
+  // Glättung blockweise, das genügt für stetige Envelopes. pow() läuft nur,
+  // wenn sich einer der k_env_params bewegt
+  void deriveEnvelopes(const float * p, Coefficients & c) const {
+    static constexpr float k_frames_per_ms = k_samplerate / 1000.f;
+    c.attack = envAttack(p[k_param_attack] * k_frames_per_ms);
+    c.release = envDecay(p[k_param_release] * k_frames_per_ms);
+    c.pitch = envDecay(p[k_param_decay] * k_frames_per_ms);
+    c.osc2 = envDecay(p[k_param_osc2_decay] * k_frames_per_ms);
+  }
+
+  // p: geglättete Parameter, Index = k_param_*
+  void deriveCoefficients(const float * p, Coefficients & c) const {
+    c.ramp[k_ramp_pitch] = p[k_param_pitch];
+    c.ramp[k_ramp_pitch_depth] = p[k_param_pitch] * p[k_param_pitch_curve];
+    c.ramp[k_ramp_osc2_inc] = p[k_param_osc2_pitch] * p[k_param_fm_ratio] * k_inv_samplerate;
+    c.ramp[k_ramp_fm_depth] = p[k_param_fm_amount] * 100.f;
+    c.ramp[k_ramp_body] = p[k_param_body_level];
+    c.ramp[k_ramp_osc2_level] = p[k_param_osc2_level];
+    c.ramp[k_ramp_click_gain] = p[k_param_click_level] * 3.0f;
+    c.ramp[k_ramp_drive_pre] = 1.f + p[k_param_drive] * 4.f;
+    c.ramp[k_ramp_drive_post] = 1.f / (1.f + p[k_param_drive] * 1.5f);
+
+    // Cutoff über die Tabelle (kein tan() zur Laufzeit), Resonanz linear
+    const float g = filterGain(p[k_param_filter_cutoff]);
+    const float k = p[k_param_filter_resonance] * k_filter_max_k;
+    const float g2 = g * g;
+    c.ramp[k_ramp_filter_g] = g;
+    c.ramp[k_ramp_filter_k] = k;
+    c.ramp[k_ramp_filter_norm] = 1.f / (1.f + k * (render_.filter_mode_24db ? g2 * g2 : g2));
+    c.ramp[k_ramp_filter_comp] = 1.f + 0.5f * k;
+  }
+#endif
+
+  inline bool lfoActive() const {
+    return render_.lfo_dest != k_lfo_off && render_.lfo_depth > 0.f;
+  }
+
+  // k_param_*, auf den das LFO-Ziel wirkt
+  inline uint32_t lfoParam() const {
+    static const uint8_t s_params[k_num_lfo_dests] = {
+      k_param_pitch, k_param_pitch, k_param_filter_cutoff, k_param_drive
+    };
+    return s_params[render_.lfo_dest];
+  }
+
+#ifdef KICK_FIXED_POINT
+  // Wie unten ganzzahlig: Sinus Q31 an der Q32-Phase, Pitch mal
+  // e^(mod ln 2), Cutoff und Drive plus mod * 50 Prozentpunkte (Q16)
+  const int32_t * modulatedParams(int32_t * buf) const {
+    static constexpr int64_t k_pitch_q31 = k_ln2_q31 * static_cast<int64_t>(k_lfo_pitch_octaves);
+    static constexpr int64_t k_amount_q16 = static_cast<int64_t>(k_lfo_amount_range * 100.f) << 16;
+    const int32_t * p = smoother_.Values();
+    if (!lfoActive()) return p;
+    std::memcpy(buf, p, k_num_params * sizeof(int32_t));
+    const int32_t mod = qrdmulh(sineQ31(lfo_.Phase()), render_.lfo_depth_q);
+    const uint32_t id = lfoParam();
+    if (render_.lfo_dest == k_lfo_pitch) {
+      buf[id] = static_cast<int32_t>(buf[id] * expQ31((mod * k_pitch_q31) >> 31) >> 31);
+    } else {
+      const int64_t x = buf[id] + ((mod * k_amount_q16) >> 31);
+      buf[id] = static_cast<int32_t>(x < 0 ? 0 : (x > (100 << 16) ? (100 << 16) : x));
+    }
+    return buf;
+  }
+
+  inline void fillRamp(size_t ramp, int32_t value) {
+    const int32x4_t v = vdupq_n_s32(value);
+    for (size_t i = 0; i < k_block_size; i += 4) {
+      vst1q_s32(ramp_buf_[ramp] + i, v);
+    }
+  }
+#else
+  // Geglättete Parameter mit der LFO-Auslenkung an der aktuellen Phase
+  // (Blockende) in buf; ohne LFO direkt die Werte des Smoothers
+  const float * modulatedParams(float * buf) const {
+    const float * p = smoother_.Values();
+    if (!lfoActive()) return p;
+    std::memcpy(buf, p, k_num_params * sizeof(float));
+    const float mod = lfo_.Value() * render_.lfo_depth;
+    const uint32_t id = lfoParam();
+    if (render_.lfo_dest == k_lfo_pitch) {
+      buf[id] *= std::exp2(mod * k_lfo_pitch_octaves);
+    } else {
+      const float x = buf[id] + mod * k_lfo_amount_range;
+      buf[id] = x < 0.f ? 0.f : (x > 1.f ? 1.f : x);
+    }
+    return buf;
+  }
+
+  inline void fillRamp(size_t ramp, float value) {
+    const float32x4_t v = vdupq_n_f32(value);
+    for (size_t i = 0; i < k_block_size; i += 4) {
+      vst1q_f32(ramp_buf_[ramp] + i, v);
+    }
+  }
+#endif
+
+  // Wird lazy vor dem nächsten Block aufgerufen, wenn render_.coeffs_dirty gesetzt ist
+  void updateCoefficients() {
+    Param modulated[k_num_params];
+    const Param * p = modulatedParams(modulated);
+    deriveEnvelopes(p, render_.coeffs);
+    deriveCoefficients(p, render_.coeffs);
+    for (size_t r = 0; r < k_num_ramps; ++r) {
+      fillRamp(r, render_.coeffs.ramp[r]);
+    }
+    render_.ramping = 0;
+    selectKernels();
+    render_.coeffs_dirty = false;
+  }
+
+  // Schaltet die bewegten Parameter um einen Block weiter und schreibt nur
+  // die davon abhängigen Koeffizienten als lineare Rampe (Blockanfang ->
+  // Blockende) nach ramp_buf_. Ruhende Parameter kosten nichts. Das LFO
+  // zählt als bewegter Parameter, sein Wert am Blockende wird so über den
+  // Block interpoliert.
+  void advanceSmoothing(size_t frames) {
+    // Parameter, von denen ein Koeffizient abhängt (Bit = k_param_*)
+    static const uint32_t s_ramp_deps[k_num_ramps] = {
+      1u << k_param_pitch,
+      (1u << k_param_pitch) | (1u << k_param_pitch_curve),
+      (1u << k_param_osc2_pitch) | (1u << k_param_fm_ratio),
+      1u << k_param_fm_amount,
+      1u << k_param_body_level,
+      1u << k_param_osc2_level,
+      1u << k_param_click_level,
+      1u << k_param_drive,
+      1u << k_param_drive,
+      1u << k_param_filter_cutoff,
+      1u << k_param_filter_resonance,
+      (1u << k_param_filter_cutoff) | (1u << k_param_filter_resonance),
+      1u << k_param_filter_resonance,
+    };
+
+    const uint32_t smoothed = smoother_.Advance(frames);
+    const uint32_t moved = lfoActive() ? smoothed | (1u << lfoParam()) : smoothed;
+    if (moved == 0 && render_.ramping == 0) return;
+
+    const Coefficients start = render_.coeffs;
+    Param modulated[k_num_params];
+    const Param * p = modulatedParams(modulated);
+    if (moved & k_env_params) deriveEnvelopes(p, render_.coeffs);
+    deriveCoefficients(p, render_.coeffs);
+#ifndef KICK_FIXED_POINT
+    const float inv_frames = 1.f / frames;
+#endif
+    uint32_t ramping = 0;
+    for (size_t r = 0; r < k_num_ramps; ++r) {
+      if (s_ramp_deps[r] & moved) {
+#ifdef KICK_FIXED_POINT
+        vramp_s32(ramp_buf_[r], start.ramp[r], render_.coeffs.ramp[r], frames);
+#else
+        vramp_f32(ramp_buf_[r], start.ramp[r], (render_.coeffs.ramp[r] - start.ramp[r]) * inv_frames, frames);
+#endif
+        ramping |= 1u << r;
+      } else if (render_.ramping & (1u << r)) {
+        fillRamp(r, render_.coeffs.ramp[r]);  // Rampe im letzten Block beendet
+      }
+    }
+    render_.ramping = ramping;
+
+    // Ein Parameter ist am Ziel: Kernel-Auswahl kann sich ändern (Drive, FM)
+    if (smoother_.Moving() != smoothed) render_.coeffs_dirty = true;
+  }
+
+  /*===========================================================================*/
+  /* Voice Pool. */
+  /*===========================================================================*/
+
+  inline bool anyVoiceActive() const {
+    uint32_t active = 0;
+    for (size_t v = 0; v < k_num_voices; ++v) {
+      active |= voices_->state[v];  // k_state_off == 0
+    }
+    return active != 0;
+  }
+
+  // Ein Transient spielt nur vorwärts, ein Block ohne Click am Anfang bleibt ohne
+  inline bool anyClickActive() const {
+    bool active = false;
+    for (size_t v = 0; v < k_num_voices; ++v) {
+      active |= voices_->click_pos[v] < voices_->click_length[v];
+    }
+    return active;
+  }
+
+  // Slots, die gerade eine Stimme abspielt (Bit = Slot)
+  inline uint32_t busyClickSlots() const {
+    uint32_t busy = 0;
+    for (size_t v = 0; v < k_num_voices; ++v) {
+      if (voices_->click_pos[v] < voices_->click_length[v]) busy |= 1u << voices_->click_slot[v];
+    }
+    return busy;
+  }
+
+  // Weist den seit dem letzten Block angeschlagenen Stimmen ihren Transienten
+  // zu. Alle Anschläge eines Blocks sehen dieselben Parameter, es wird also
+  // höchstens ein Slot neu berechnet. Der Click folgt den Zielwerten, eine
+  // laufende Glättung wirkt erst auf den nächsten Anschlag
+  void resolveClicks() {
+#ifdef KICK_FIXED_POINT
+    ClickKeyQ key;
+    key.inc = static_cast<uint32_t>(hzToInc(smoother_.Target(k_param_click_freq)));
+    key.frames = static_cast<uint32_t>(smoother_.Target(k_param_click_decay)) * (k_samplerate_hz / 1000);
+    key.tone = pctQ31(smoother_.Target(k_param_click_tone));
+    key.seed = controls_.click_seed;
+#else
+    ClickKey key;
+    key.inc = smoother_.Target(k_param_click_freq) * k_inv_samplerate;
+    key.dec = 1.f / (smoother_.Target(k_param_click_decay) / 1000.f * k_samplerate);
+    key.tone = smoother_.Target(k_param_click_tone);
+    key.seed = controls_.click_seed;
+    key.tier = render_.sine_tier;
+#endif
+    const uint8_t slot = static_cast<uint8_t>(click_cache_.Acquire(key, busyClickSlots()));
+    for (size_t v = 0; v < k_num_voices; ++v) {
+      if (render_.click_pending & (1u << v)) {
+        voices_->click_slot[v] = slot;
+        voices_->click_pos[v] = 0;
+        voices_->click_length[v] = click_cache_.Length(slot);
+      }
+    }
+    render_.click_pending = 0;
+  }
+
+#ifdef KICK_FREEZE
+  // Summe der eingefrorenen Stimmen nach freeze_buf_, beendete Stimmen fallen heraus
+  void mixFrozen(size_t frames) {
+    std::memset(freeze_buf_, 0, frames * sizeof(Sample));
+    const uint32_t length = hit_cache_.Length();
+    for (size_t v = 0; v < k_num_voices; ++v) {
+      if (!(render_.frozen_voices & (1u << v))) continue;
+      const uint32_t pos = voices_->frozen_pos[v];
+#ifdef KICK_FIXED_POINT
+      hit_cache_.Mix(freeze_buf_, pos, voices_->gain_q[v], frames);
+#else
+      hit_cache_.Mix(freeze_buf_, pos, 1.3f * voices_->velocity[v], frames);
+#endif
+      if (pos + frames < length) {
+        voices_->frozen_pos[v] = static_cast<uint32_t>(pos + frames);
+      } else {
+        render_.frozen_voices &= ~(1u << v);
+      }
+    }
+  }
+
+  // Hängt den Block der Aufnahme-Stimme an, bis sie k_state_off erreicht
+  inline void recordHit(size_t frames) {
+#ifdef KICK_FIXED_POINT
+    if (!hit_cache_.Append(mix_q_, env_q_, render_.hit_voice, frames)) return;  // Treffer zu lang
+#else
+    if (!hit_cache_.Append(mix_buf_, env_buf_, render_.hit_voice, frames)) return;  // Treffer zu lang
+#endif
+    if (voices_->state[render_.hit_voice] == k_state_off) hit_cache_.Finish();
+  }
+#endif
+
+  // Freie Stimme innerhalb der Polyphonie, sonst nach controls_.steal_mode klauen
+  size_t allocateVoice() const {
+    for (size_t v = 0; v < controls_.polyphony; ++v) {
+      if (voices_->state[v] == k_state_off && !(render_.frozen_voices & (1u << v))) return v;
+    }
+    size_t best = 0;
+    if (controls_.steal_mode == k_steal_oldest) {
+      uint32_t oldest = 0;
+      for (size_t v = 0; v < controls_.polyphony; ++v) {
+        const uint32_t age = controls_.note_counter - voices_->age[v];  // überlauffest
+        if (age >= oldest) {
+          oldest = age;
+          best = v;
+        }
+      }
+    } else {
+#ifdef KICK_FIXED_POINT
+      // Envelope Q31 mal Verstärkung Q27
+      int64_t quietest = INT64_MAX;
+      for (size_t v = 0; v < controls_.polyphony; ++v) {
+        const int64_t env = (render_.frozen_voices & (1u << v))
+            ? INT32_MAX - (static_cast<int64_t>(voices_->frozen_pos[v]) << 31) / hit_cache_.Length()
+            : voices_->envelope_q[v];
+        const int64_t level = env * voices_->gain_q[v];
+        if (level < quietest) {
+          quietest = level;
+          best = v;
+        }
+      }
+#else
+      float quietest = 2.f;
+      for (size_t v = 0; v < controls_.polyphony; ++v) {
+        // Eingefrorene Stimmen haben keine Envelope, grob über die Position geschätzt
+        const float env = (render_.frozen_voices & (1u << v))
+            ? 1.f - static_cast<float>(voices_->frozen_pos[v]) / hit_cache_.Length() : voices_->envelope[v];
+        const float level = env * voices_->velocity[v];
+        if (level < quietest) {
+          quietest = level;
+          best = v;
+        }
+      }
+#endif
+    }
+    return best;
+  }
+
+  /*===========================================================================*/
+  /* Block Renderer Stages. */
+  /*===========================================================================*/
+
+  // Lesezeiger jeder Stimme in den Click-Cache für diesen Block, rückt die
+  // Positionen um frames weiter
+  inline void clickSources(const Sample ** src, size_t frames) {
+    for (size_t v = 0; v < k_num_voices; ++v) {
+      const uint32_t pos = voices_->click_pos[v];
+      const uint32_t length = voices_->click_length[v];
+      if (pos < length) {
+        src[v] = click_cache_.Data(voices_->click_slot[v]) + pos;
+        voices_->click_pos[v] = pos + frames < length ? static_cast<uint32_t>(pos + frames) : length;
+      } else {
+        src[v] = click_cache_.Silence();
+      }
+    }
+  }
+
+#ifndef KICK_FIXED_POINT
+  // Amp-Envelope als Zustandsautomat je Lane (Attack -> Decay/Release ->
+  // Off), dazu Pitch-/OSC2-Envelope, die nur laufen, solange die Stimme
+  // aktiv ist. Jede Envelope ist ein exponentielles Segment (envelope.h),
+  // ein vmla pro Frame für alle vier Stimmen. Über die geschlossene Form
+  // steht vorab fest, ob im Block eine Lane den Zustand wechselt; wenn
+  // nicht, entfallen Vergleiche und Zustandsauswahl ganz.
+  void renderEnvelopes(size_t frames) {
+    const Coefficients & c = render_.coeffs;
+    if (envelopesSteady(frames)) {
+      renderEnvelopesSteady(frames);
+      return;
+    }
+
+    const float32x4_t k_attack = vdupq_n_f32(c.attack.k);
+    const float32x4_t b_attack = vdupq_n_f32(c.attack.b);
+    const float32x4_t k_release = vdupq_n_f32(c.release.k);
+    const float32x4_t b_release = vdupq_n_f32(c.release.b);
+    const float32x4_t k_pitch = vdupq_n_f32(c.pitch.k);
+    const float32x4_t b_pitch = vdupq_n_f32(c.pitch.b);
+    const float32x4_t k_osc2 = vdupq_n_f32(c.osc2.k);
+    const float32x4_t b_osc2 = vdupq_n_f32(c.osc2.b);
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    const float32x4_t one = vdupq_n_f32(1.f);
+    const uint32x4_t state_off = vdupq_n_u32(k_state_off);
+    const uint32x4_t state_attack = vdupq_n_u32(k_state_attack);
+    const uint32x4_t state_decay = vdupq_n_u32(k_state_decay);
+
+    uint32x4_t state = vld1q_u32(voices_->state);
+    float32x4_t env = vld1q_f32(voices_->envelope);
+    float32x4_t pitch_env = vld1q_f32(voices_->pitch_envelope);
+    float32x4_t osc2_env = vld1q_f32(voices_->osc2_envelope);
+    for (size_t i = 0; i < frames; ++i) {
+      // Attack steigt bis 1, Decay und Release fallen bis 0. Off-Lanes mit
+      // k = 1, b = 0, der Wert steht
+      const uint32x4_t attack = vceqq_u32(state, state_attack);
+      const uint32x4_t falling = vcgeq_u32(state, state_decay);
+      const float32x4_t k = vbslq_f32(attack, k_attack, vbslq_f32(falling, k_release, one));
+      const float32x4_t b = vbslq_f32(attack, b_attack, vbslq_f32(falling, b_release, zero));
+      env = vmlaq_f32(b, env, k);
+      const uint32x4_t peak = vandq_u32(attack, vcgeq_f32(env, one));
+      const uint32x4_t end = vandq_u32(falling, vcleq_f32(env, zero));
+      env = vbslq_f32(peak, one, vbslq_f32(end, zero, env));
+      state = vbslq_u32(peak, state_decay, vbslq_u32(end, state_off, state));
+
+      const uint32x4_t active = vcgtq_u32(state, state_off);
+      pitch_env = vbslq_f32(active, vmaxq_f32(vmlaq_f32(b_pitch, pitch_env, k_pitch), zero), pitch_env);
+      osc2_env = vbslq_f32(active, vmaxq_f32(vmlaq_f32(b_osc2, osc2_env, k_osc2), zero), osc2_env);
+
+      vst1q_f32(env_buf_ + (i << 2), env);
+      vst1q_f32(pitch_env_buf_ + (i << 2), pitch_env);
+      vst1q_f32(osc2_env_buf_ + (i << 2), osc2_env);
+    }
+    vst1q_u32(voices_->state, state);
+    vst1q_f32(voices_->envelope, env);
+    vst1q_f32(voices_->pitch_envelope, pitch_env);
+    vst1q_f32(voices_->osc2_envelope, osc2_env);
+  }
+
+  // Kein Attack und keine fallende Lane erreicht in frames Samples die 0,
+  // der Zustand bleibt also über den ganzen Block. Der Abstand fängt den
+  // Rundungsunterschied zwischen geschlossener Form und Rekursion ab
+  inline bool envelopesSteady(size_t frames) const {
+    static constexpr float k_margin = 1e-4f;
+    const EnvSegment & release = render_.coeffs.release;
+    const float k_n = envPow(release.k, frames);
+    for (size_t v = 0; v < k_num_voices; ++v) {
+      const uint32_t state = voices_->state[v];
+      if (state == k_state_attack) return false;
+      if (state != k_state_off &&
+          release.target + (voices_->envelope[v] - release.target) * k_n <= k_margin) return false;
+    }
+    return true;
+  }
+
+  // renderEnvelopes() ohne Zustandswechsel: Koeffizienten je Lane stehen
+  // für den Block fest, Off-Lanes behalten ihre Werte
+  void renderEnvelopesSteady(size_t frames) {
+    const Coefficients & c = render_.coeffs;
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    const float32x4_t one = vdupq_n_f32(1.f);
+    const uint32x4_t active = vcgtq_u32(vld1q_u32(voices_->state), vdupq_n_u32(k_state_off));
+    const float32x4_t k_env = vbslq_f32(active, vdupq_n_f32(c.release.k), one);
+    const float32x4_t b_env = vbslq_f32(active, vdupq_n_f32(c.release.b), zero);
+    const float32x4_t k_pitch = vbslq_f32(active, vdupq_n_f32(c.pitch.k), one);
+    const float32x4_t b_pitch = vbslq_f32(active, vdupq_n_f32(c.pitch.b), zero);
+    const float32x4_t k_osc2 = vbslq_f32(active, vdupq_n_f32(c.osc2.k), one);
+    const float32x4_t b_osc2 = vbslq_f32(active, vdupq_n_f32(c.osc2.b), zero);
+
+    float32x4_t env = vld1q_f32(voices_->envelope);
+    float32x4_t pitch_env = vld1q_f32(voices_->pitch_envelope);
+    float32x4_t osc2_env = vld1q_f32(voices_->osc2_envelope);
+    for (size_t i = 0; i < frames; ++i) {
+      env = vmlaq_f32(b_env, env, k_env);
+      pitch_env = vmaxq_f32(vmlaq_f32(b_pitch, pitch_env, k_pitch), zero);
+      osc2_env = vmaxq_f32(vmlaq_f32(b_osc2, osc2_env, k_osc2), zero);
+      vst1q_f32(env_buf_ + (i << 2), env);
+      vst1q_f32(pitch_env_buf_ + (i << 2), pitch_env);
+      vst1q_f32(osc2_env_buf_ + (i << 2), osc2_env);
+    }
+    vst1q_f32(voices_->envelope, env);
+    vst1q_f32(voices_->pitch_envelope, pitch_env);
+    vst1q_f32(voices_->osc2_envelope, osc2_env);
+  }
+
+  inline void sineBlock(float * dst, const float * phase, size_t lanes) const {
+    sineBlockTier(render_.sine_tier, dst, phase, lanes);
+  }
+
+  // OSC2 ohne Pegel/Envelope. Saw, Triangle und Pulse bandbegrenzt (osc.h)
+  // mit dem Phaseninkrement je Lane aus inc2_buf_
+  template <uint8_t kWave>
+  void renderOsc2(float * __restrict dst, const float * __restrict phase, size_t frames) {
+    const size_t lanes = frames * k_num_voices;
+    if (kWave == k_wave_saw) {
+      sawBlock<true>(dst, phase, inc2_buf_, lanes);
+    } else if (kWave == k_wave_triangle) {
+      triangleBlock<true>(dst, phase, inc2_buf_, lanes);
+    } else if (kWave == k_wave_pulse) {
+      pulseBlock<true>(dst, phase, inc2_buf_, lanes, render_.pulse_width);
+    } else if (kWave == k_wave_noise) {
+      osc2_noise_.Render(dst, frames);
+    } else {
+      sineBlock(dst, phase, lanes);
+    }
+  }
+
+  // Vorberechneter Click (Mischung, Hochpass, Envelope) aus dem Cache mal
+  // Pegel, addiert auf mix_buf_. Stimmen ohne Click lesen Nullen, das Ende
+  // jedes Slots ist mit k_block_size Nullen aufgefüllt
+  void renderClick(size_t frames) {
+    const float * src[k_num_voices];
+    clickSources(src, frames);
+
+    const float * level = ramp_buf_[k_ramp_click_gain];
+    const bool spread = spreadBlock();
+    for (size_t i = 0; i < frames; ++i) {
+      float32x4_t click = vld1q_dup_f32(src[0] + i);
+      click = vld1q_lane_f32(src[1] + i, click, 1);
+      click = vld1q_lane_f32(src[2] + i, click, 2);
+      click = vld1q_lane_f32(src[3] + i, click, 3);
+      float * dst = mix_buf_ + (i << 2);
+      vst1q_f32(dst, vmlaq_f32(vld1q_f32(dst), click, vld1q_dup_f32(level + i)));
+      if (spread) {
+        float * tr = transient_buf_ + (i << 2);
+        vst1q_f32(tr, vmlaq_f32(vld1q_f32(tr), click, vld1q_dup_f32(level + i)));
+      }
+    }
+  }
+
+  // TPT-Ladder aus kPoles gleichen Einpol-Tiefpässen (12dB: 2, 24dB: 4) mit
+  // verzögerungsfreier Resonanz-Rückkopplung. Rekursiv über die Zeit,
+  // parallel über die Stimmen; die Zustände liegen als [Pol][Stimme].
+  template <size_t kPoles>
+  void renderFilter(float * __restrict buf, size_t frames) {
+    const size_t lanes = frames * k_num_voices;
+    const float * gain = ramp_buf_[k_ramp_filter_g];
+    const float * feedback = ramp_buf_[k_ramp_filter_k];
+    const float * norm = ramp_buf_[k_ramp_filter_norm];
+    const float * comp = ramp_buf_[k_ramp_filter_comp];
+    const float32x4_t one = vdupq_n_f32(1.f);
+
+    float32x4_t s[kPoles];
+    for (size_t p = 0; p < kPoles; ++p) {
+      s[p] = vld1q_f32(voices_->filter_state[p]);
+    }
+    for (size_t i = 0; i < lanes; i += 4) {
+      const size_t f = i >> 2;
+      const float32x4_t g = vld1q_dup_f32(gain + f);
+
+      // Ausgang der Kette ohne Rückkopplung: G^n * x + (1 - G) * (s0 G^(n-1) + ... + s(n-1))
+      float32x4_t sigma = s[0];
+      float32x4_t gn = g;
+      for (size_t p = 1; p < kPoles; ++p) {
+        sigma = vmlaq_f32(s[p], sigma, g);
+        gn = vmulq_f32(gn, g);
+      }
+      sigma = vmulq_f32(sigma, vsubq_f32(one, g));
+      const float32x4_t x = vmulq_f32(vld1q_f32(buf + i), vld1q_dup_f32(comp + f));
+      const float32x4_t y = vmulq_f32(vmlaq_f32(sigma, gn, x), vld1q_dup_f32(norm + f));
+
+      // Eingang mit Rückkopplung durch alle Stufen: v = G (u - s), y = v + s, s = y + v
+      float32x4_t u = vmlsq_f32(x, y, vld1q_dup_f32(feedback + f));
+      for (size_t p = 0; p < kPoles; ++p) {
+        const float32x4_t v = vmulq_f32(vsubq_f32(u, s[p]), g);
+        u = vaddq_f32(v, s[p]);
+        s[p] = vaddq_f32(u, v);
+      }
+      vst1q_f32(buf + i, u);
+    }
+    for (size_t p = 0; p < kPoles; ++p) {
+      vst1q_f32(voices_->filter_state[p], s[p]);
+    }
+  }
+
+#endif
+
+  /*===========================================================================*/
+  /* Specialized Stage Kernels. */
+  /*===========================================================================*/
+
+  typedef void (Synth::*StageFn)(size_t frames);
+
+#ifndef KICK_FIXED_POINT
+  // Phasen, Körper und OSC2 in mix_buf_. kWave == k_num_waves steht für OSC2 aus.
+  template <uint8_t kWave, bool kFm>
+  void oscStage(size_t frames) {
+    const size_t lanes = frames * k_num_voices;
+
+    // current_pitch = pitch - pitch_env * pitch_depth in freq_buf_, dazu
+    // Phase 2 nach dem Update und ihr Inkrement (inc2_buf_, für die
+    // Bandbegrenzung); für die FM die Phase vor dem Update in tmp_buf_
+    {
+      const float * pitch = ramp_buf_[k_ramp_pitch];
+      const float * depth = ramp_buf_[k_ramp_pitch_depth];
+      const float * scale2 = ramp_buf_[k_ramp_osc2_inc];
+      float32x4_t phase2 = vld1q_f32(voices_->phase2);
+      for (size_t i = 0; i < lanes; i += 4) {
+        const size_t f = i >> 2;
+        const float32x4_t current_pitch = vmlsq_f32(vld1q_dup_f32(pitch + f), vld1q_f32(pitch_env_buf_ + i),
+                                                    vld1q_dup_f32(depth + f));
+        vst1q_f32(freq_buf_ + i, current_pitch);
+        if (kFm) vst1q_f32(tmp_buf_ + i, phase2);
+        const float32x4_t inc2 = vmulq_f32(current_pitch, vld1q_dup_f32(scale2 + f));
+        if (kWave == k_wave_saw || kWave == k_wave_triangle || kWave == k_wave_pulse) vst1q_f32(inc2_buf_ + i, inc2);
+        phase2 = vfrac_f32(vaddq_f32(phase2, inc2));
+        vst1q_f32(phase2_buf_ + i, phase2);
+      }
+      vst1q_f32(voices_->phase2, phase2);
+    }
+
+    // FM auf die Frequenz von Oszillator 1
+    if (kFm) {
+      const float * amount = ramp_buf_[k_ramp_fm_depth];
+      sineBlock(tmp_buf_, tmp_buf_, lanes);
+      for (size_t i = 0; i < lanes; i += 4) {
+        const float32x4_t fm_mod = vmulq_f32(vmulq_f32(vld1q_f32(tmp_buf_ + i), vld1q_dup_f32(amount + (i >> 2))),
+                                             vld1q_f32(osc2_env_buf_ + i));
+        vst1q_f32(freq_buf_ + i, vaddq_f32(vld1q_f32(freq_buf_ + i), fm_mod));
+      }
+    }
+
+    // Phase 1 (in mix_buf_), vfrac fängt auch negative FM-Auslenkung ab
+    {
+      const float32x4_t inv_sr = vdupq_n_f32(k_inv_samplerate);
+      float32x4_t phase1 = vld1q_f32(voices_->phase1);
+      for (size_t i = 0; i < lanes; i += 4) {
+        phase1 = vfrac_f32(vmlaq_f32(phase1, vld1q_f32(freq_buf_ + i), inv_sr));
+        vst1q_f32(mix_buf_ + i, phase1);
+      }
+      vst1q_f32(voices_->phase1, phase1);
+    }
+
+    // Körper: sin(phase1) * Body-Level
+    sineBlock(mix_buf_, mix_buf_, lanes);
+    {
+      const float * body_level = ramp_buf_[k_ramp_body];
+      for (size_t i = 0; i < lanes; i += 4) {
+        vst1q_f32(mix_buf_ + i, vmulq_f32(vld1q_f32(mix_buf_ + i), vld1q_dup_f32(body_level + (i >> 2))));
+      }
+    }
+
+    // OSC2, mit Stereo-Breite auch als Anfang von transient_buf_
+    const bool spread = spreadBlock();
+    if (kWave < k_num_waves) {
+      renderOsc2<kWave>(tmp_buf_, phase2_buf_, frames);
+      const float * level = ramp_buf_[k_ramp_osc2_level];
+      for (size_t i = 0; i < lanes; i += 4) {
+        const float32x4_t osc2 = vmulq_f32(vmulq_f32(vld1q_f32(tmp_buf_ + i), vld1q_dup_f32(level + (i >> 2))),
+                                           vld1q_f32(osc2_env_buf_ + i));
+        vst1q_f32(mix_buf_ + i, vaddq_f32(vld1q_f32(mix_buf_ + i), osc2));
+        if (spread) vst1q_f32(transient_buf_ + i, osc2);
+      }
+    } else if (spread) {
+      std::memset(transient_buf_, 0, lanes * sizeof(float));
+    }
+  }
+
+#else
+  /*===========================================================================*/
+  /* Fixed-Point Kernel. */
+  /*===========================================================================*/
+
+  // Der ganze Signalweg in Q-Format (fixed.h) statt float: Koeffizienten
+  // (deriveCoefficients()), Envelopes, Oszillatoren, Click, Drive, Filter,
+  // Summe der Stimmen, Freeze, Stereo-Breite und Limiter. float entsteht
+  // erst beim Store in writeOutput(). Drive läuft auf Basisrate, OSC2
+  // naiv, der Sinus immer als Polynom 7. Grades.
+
+  // Wie renderEnvelopes() in Q31. Der Attack zielt über 1 hinaus und
+  // sättigt dort, so erkennt vqadd den Gipfel. Off-Lanes laufen mit k = b = 0
+  // (ihre Envelope ist 0)
+  void renderEnvelopesQ(size_t frames) {
+    const Coefficients & c = render_.coeffs;
+    const int32x4_t k_attack = vdupq_n_s32(c.attack.k);
+    const int32x4_t b_attack = vdupq_n_s32(c.attack.b);
+    const int32x4_t k_release = vdupq_n_s32(c.release.k);
+    const int32x4_t b_release = vdupq_n_s32(c.release.b);
+    const int32x4_t k_pitch = vdupq_n_s32(c.pitch.k);
+    const int32x4_t b_pitch = vdupq_n_s32(c.pitch.b);
+    const int32x4_t k_osc2 = vdupq_n_s32(c.osc2.k);
+    const int32x4_t b_osc2 = vdupq_n_s32(c.osc2.b);
+    const int32x4_t zero = vdupq_n_s32(0);
+    const int32x4_t one = vdupq_n_s32(INT32_MAX);
+    const uint32x4_t state_off = vdupq_n_u32(k_state_off);
+    const uint32x4_t state_attack = vdupq_n_u32(k_state_attack);
+    const uint32x4_t state_decay = vdupq_n_u32(k_state_decay);
+
+    uint32x4_t state = vld1q_u32(voices_->state);
+    int32x4_t env = vld1q_s32(voices_->envelope_q);
+    int32x4_t pitch_env = vld1q_s32(voices_->pitch_envelope_q);
+    int32x4_t osc2_env = vld1q_s32(voices_->osc2_envelope_q);
+    for (size_t i = 0; i < frames; ++i) {
+      const uint32x4_t attack = vceqq_u32(state, state_attack);
+      const uint32x4_t falling = vcgeq_u32(state, state_decay);
+      const int32x4_t k = vbslq_s32(attack, k_attack, vbslq_s32(falling, k_release, zero));
+      const int32x4_t b = vbslq_s32(attack, b_attack, vbslq_s32(falling, b_release, zero));
+      env = vqaddq_s32(vqrdmulhq_s32(env, k), b);
+      const uint32x4_t peak = vandq_u32(attack, vcgeq_s32(env, one));
+      const uint32x4_t end = vandq_u32(falling, vcgeq_s32(zero, env));
+      env = vbslq_s32(end, zero, env);
+      state = vbslq_u32(peak, state_decay, vbslq_u32(end, state_off, state));
+
+      const uint32x4_t active = vcgtq_u32(state, state_off);
+      pitch_env = vbslq_s32(active, vmaxq_s32(vqaddq_s32(vqrdmulhq_s32(pitch_env, k_pitch), b_pitch), zero), pitch_env);
+      osc2_env = vbslq_s32(active, vmaxq_s32(vqaddq_s32(vqrdmulhq_s32(osc2_env, k_osc2), b_osc2), zero), osc2_env);
+
+      vst1q_s32(env_q_ + (i << 2), env);
+      vst1q_s32(pitch_env_q_ + (i << 2), pitch_env);
+      vst1q_s32(osc2_env_q_ + (i << 2), osc2_env);
+    }
+    vst1q_u32(voices_->state, state);
+    vst1q_s32(voices_->envelope_q, env);
+    vst1q_s32(voices_->pitch_envelope_q, pitch_env);
+    vst1q_s32(voices_->osc2_envelope_q, osc2_env);
+  }
+
+  // Wie oscStage() in Q-Format: Phasen wickeln als uint32 von selbst,
+  // negative FM-Inkremente laufen rückwärts
+  template <uint8_t kWave, bool kFm>
+  void oscStageQ(size_t frames) {
+    const size_t lanes = frames * k_num_voices;
+
+    // Inkrement Oszillator 1 ohne FM (inc_q_), Phase 2 nach dem Update; für
+    // die FM die Phase davor in tmp_q_
+    {
+      const int32_t * pitch = ramp_buf_[k_ramp_pitch];
+      const int32_t * depth = ramp_buf_[k_ramp_pitch_depth];
+      const int32_t * ratio = ramp_buf_[k_ramp_osc2_inc];
+      uint32x4_t phase2 = vld1q_u32(voices_->phase2_q);
+      for (size_t i = 0; i < lanes; i += 4) {
+        const size_t f = i >> 2;
+        const int32x4_t inc = vsubq_s32(vdupq_n_s32(pitch[f]),
+                                        vqrdmulhq_s32(vld1q_s32(pitch_env_q_ + i), vdupq_n_s32(depth[f])));
+        vst1q_s32(inc_q_ + i, inc);
+        if (kFm) vst1q_s32(tmp_q_ + i, vreinterpretq_s32_u32(phase2));
+        const int32x4_t inc2 = vqshlq_n_s32(vqrdmulhq_s32(inc, vdupq_n_s32(ratio[f])), 5);  // Q26
+        phase2 = vaddq_u32(phase2, vreinterpretq_u32_s32(inc2));
+        vst1q_u32(phase2_q_ + i, phase2);
+      }
+      vst1q_u32(voices_->phase2_q, phase2);
+    }
+
+    if (kFm) {
+      const int32_t * amount = ramp_buf_[k_ramp_fm_depth];
+      for (size_t i = 0; i < lanes; i += 4) {
+        const int32x4_t mod = vsine_q31(vreinterpretq_u32_s32(vld1q_s32(tmp_q_ + i)));
+        const int32x4_t fm = vqrdmulhq_s32(vqrdmulhq_s32(mod, vdupq_n_s32(amount[i >> 2])), vld1q_s32(osc2_env_q_ + i));
+        vst1q_s32(inc_q_ + i, vaddq_s32(vld1q_s32(inc_q_ + i), fm));
+      }
+    }
+
+    // Phase 1 und Körper: sin(phase1) * Body-Level -> mix_q_
+    {
+      const int32_t * body = ramp_buf_[k_ramp_body];
+      uint32x4_t phase1 = vld1q_u32(voices_->phase1_q);
+      for (size_t i = 0; i < lanes; i += 4) {
+        phase1 = vaddq_u32(phase1, vreinterpretq_u32_s32(vld1q_s32(inc_q_ + i)));
+        vst1q_s32(mix_q_ + i, vq27_q31(vqrdmulhq_s32(vsine_q31(phase1), vdupq_n_s32(body[i >> 2]))));
+      }
+      vst1q_u32(voices_->phase1_q, phase1);
+    }
+
+    // OSC2 naiv aus Phase 2, mit Stereo-Breite auch nach transient_buf_
+    const bool spread = spreadBlock();
+    if (kWave < k_num_waves) {
+      if (kWave == k_wave_noise) osc2_noise_.RenderQ31(tmp_q_, frames);
+      const int32_t * level = ramp_buf_[k_ramp_osc2_level];
+      const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+      const uint32x4_t width = vdupq_n_u32(render_.pulse_width_q);
+      for (size_t i = 0; i < lanes; i += 4) {
+        const uint32x4_t p = vld1q_u32(phase2_q_ + i);
+        int32x4_t w;
+        if (kWave == k_wave_saw) {
+          w = vreinterpretq_s32_u32(veorq_u32(p, sign));  // 2t - 1
+        } else if (kWave == k_wave_triangle) {
+          const int32x4_t ramp = vqabsq_s32(vreinterpretq_s32_u32(veorq_u32(p, sign)));
+          w = vqshlq_n_s32(vsubq_s32(ramp, vdupq_n_s32(1 << 30)), 1);  // 2|2t - 1| - 1
+        } else if (kWave == k_wave_pulse) {
+          w = vbslq_s32(vcltq_u32(p, width), vdupq_n_s32(INT32_MAX), vdupq_n_s32(-INT32_MAX));
+        } else if (kWave == k_wave_noise) {
+          w = vld1q_s32(tmp_q_ + i);
+        } else {
+          w = vsine_q31(p);
+        }
+        const int32x4_t osc2 = vq27_q31(vqrdmulhq_s32(vqrdmulhq_s32(w, vdupq_n_s32(level[i >> 2])),
+                                                      vld1q_s32(osc2_env_q_ + i)));
+        vst1q_s32(mix_q_ + i, vqaddq_s32(vld1q_s32(mix_q_ + i), osc2));
+        if (spread) vst1q_s32(transient_buf_ + i, osc2);
+      }
+    } else if (spread) {
+      std::memset(transient_buf_, 0, lanes * sizeof(int32_t));
+    }
+  }
+
+  // Wie renderClick(), Cache (ClickKeyQ) und Pegel in Q27
+  void renderClickQ(size_t frames) {
+    const int32_t * src[k_num_voices];
+    clickSources(src, frames);
+
+    const int32_t * level = ramp_buf_[k_ramp_click_gain];
+    const bool spread = spreadBlock();
+    for (size_t i = 0; i < frames; ++i) {
+      alignas(16) const int32_t lanes[k_num_voices] = {src[0][i], src[1][i], src[2][i], src[3][i]};
+      const int32x4_t click = vmulq_q27(vld1q_s32(lanes), vdupq_n_s32(level[i]));
+      int32_t * dst = mix_q_ + (i << 2);
+      vst1q_s32(dst, vqaddq_s32(vld1q_s32(dst), click));
+      if (spread) {
+        int32_t * tr = transient_buf_ + (i << 2);
+        vst1q_s32(tr, vqaddq_s32(vld1q_s32(tr), click));
+      }
+    }
+  }
+
+  // renderFilter() in Q27, Koeffizienten G und norm Q31, k und comp Q27
+  template <size_t kPoles>
+  void renderFilterQ(size_t frames) {
+    const size_t lanes = frames * k_num_voices;
+    const int32_t * gain = ramp_buf_[k_ramp_filter_g];
+    const int32_t * feedback = ramp_buf_[k_ramp_filter_k];
+    const int32_t * norm = ramp_buf_[k_ramp_filter_norm];
+    const int32_t * comp = ramp_buf_[k_ramp_filter_comp];
+    const int32x4_t one = vdupq_n_s32(INT32_MAX);
+
+    int32x4_t s[kPoles];
+    for (size_t p = 0; p < kPoles; ++p) {
+      s[p] = vld1q_s32(voices_->filter_state_q[p]);
+    }
+    for (size_t i = 0; i < lanes; i += 4) {
+      const size_t f = i >> 2;
+      const int32x4_t g = vdupq_n_s32(gain[f]);
+
+      int32x4_t sigma = s[0];
+      int32x4_t gn = g;
+      for (size_t p = 1; p < kPoles; ++p) {
+        sigma = vqaddq_s32(s[p], vqrdmulhq_s32(sigma, g));
+        gn = vqrdmulhq_s32(gn, g);
+      }
+      sigma = vqrdmulhq_s32(sigma, vqsubq_s32(one, g));
+      const int32x4_t x = vmulq_q27(vld1q_s32(mix_q_ + i), vdupq_n_s32(comp[f]));
+      const int32x4_t y = vqrdmulhq_s32(vqaddq_s32(sigma, vqrdmulhq_s32(x, gn)), vdupq_n_s32(norm[f]));
+
+      int32x4_t u = vqsubq_s32(x, vmulq_q27(y, vdupq_n_s32(feedback[f])));
+      for (size_t p = 0; p < kPoles; ++p) {
+        const int32x4_t v = vqrdmulhq_s32(vqsubq_s32(u, s[p]), g);
+        u = vqaddq_s32(v, s[p]);
+        s[p] = vqaddq_s32(u, v);
+      }
+      vst1q_s32(mix_q_ + i, u);
+    }
+    for (size_t p = 0; p < kPoles; ++p) {
+      vst1q_s32(voices_->filter_state_q[p], s[p]);
+    }
+  }
+
+  // Drive (tanh-Tabelle Q31) und Filter auf mix_q_
+  template <bool kDrive, uint8_t kFilter>
+  void shapeStageQ(size_t frames) {
+    const size_t lanes = frames * k_num_voices;
+    if (kDrive) {
+      const int32_t * pre = ramp_buf_[k_ramp_drive_pre];
+      const int32_t * post = ramp_buf_[k_ramp_drive_post];
+      for (size_t i = 0; i < lanes; i += 4) {
+        const int32x4_t x = vtanh_q31(vmulq_q27(vld1q_s32(mix_q_ + i), vdupq_n_s32(pre[i >> 2])));
+        vst1q_s32(mix_q_ + i, vq27_q31(vqrdmulhq_s32(x, vdupq_n_s32(post[i >> 2]))));
+      }
+    }
+    if (kFilter != k_filter_off) {
+      renderFilterQ<kFilter == k_filter_24db ? 4 : 2>(frames);
+    }
+  }
+
+  // Summe mix * env * Verstärkung über die Stimmen nach dst (Layout
+  // [Frame]), plus add, falls gesetzt. Gesättigt in Stimmenreihenfolge
+  void sumVoicesQ(int32_t * __restrict dst, const int32_t * __restrict mix, const int32_t * __restrict add,
+                  size_t frames) const {
+    const int32_t * gain = voices_->gain_q;
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+      // 4 Frames x 4 Stimmen transponiert: val[v] = Stimme v über 4 Frames
+      const int32x4x4_t m = vld4q_s32(mix + (i << 2));
+      const int32x4x4_t e = vld4q_s32(env_q_ + (i << 2));
+      int32x4_t x = vmulq_q27(vqrdmulhq_s32(m.val[0], e.val[0]), vdupq_n_s32(gain[0]));
+      x = vqaddq_s32(x, vmulq_q27(vqrdmulhq_s32(m.val[1], e.val[1]), vdupq_n_s32(gain[1])));
+      x = vqaddq_s32(x, vmulq_q27(vqrdmulhq_s32(m.val[2], e.val[2]), vdupq_n_s32(gain[2])));
+      x = vqaddq_s32(x, vmulq_q27(vqrdmulhq_s32(m.val[3], e.val[3]), vdupq_n_s32(gain[3])));
+      if (add) x = vqaddq_s32(x, vld1q_s32(add + i));
+      vst1q_s32(dst + i, x);
+    }
+    for (; i < frames; ++i) {
+      int32_t x = mulQ27(qrdmulh(mix[i << 2], env_q_[i << 2]), gain[0]);
+      for (size_t v = 1; v < k_num_voices; ++v) {
+        x = qadd(x, mulQ27(qrdmulh(mix[(i << 2) + v], env_q_[(i << 2) + v]), gain[v]));
+      }
+      if (add) x = qadd(x, add[i]);
+      dst[i] = x;
+    }
+  }
+#endif
+
+  // Teilt arena_ auf, einmal im Konstruktor. Reihenfolge und Größen wie in
+  // den k_*_bytes, Render() allokiert nie
+  void layoutArena() {
+    arena_.Reset();
+
+    voices_ = arena_.Allocate<Voices>(1);  // Erste Slice: beginnt auf einer Cache-Line
+
+#ifdef KICK_FIXED_POINT
+    env_q_ = arena_.Allocate<int32_t>(k_block_floats);
+    pitch_env_q_ = arena_.Allocate<int32_t>(k_block_floats);
+    osc2_env_q_ = arena_.Allocate<int32_t>(k_block_floats);
+    inc_q_ = arena_.Allocate<int32_t>(k_block_floats);
+    phase2_q_ = arena_.Allocate<uint32_t>(k_block_floats);
+    mix_q_ = arena_.Allocate<int32_t>(k_block_floats);
+    tmp_q_ = arena_.Allocate<int32_t>(k_block_floats);
+#else
+    env_buf_ = arena_.Allocate<float>(k_block_floats);
+    pitch_env_buf_ = arena_.Allocate<float>(k_block_floats);
+    osc2_env_buf_ = arena_.Allocate<float>(k_block_floats);
+    freq_buf_ = arena_.Allocate<float>(k_block_floats);
+    phase2_buf_ = arena_.Allocate<float>(k_block_floats);
+    inc2_buf_ = arena_.Allocate<float>(k_block_floats);
+    mix_buf_ = arena_.Allocate<float>(k_block_floats);
+    tmp_buf_ = arena_.Allocate<float>(k_block_floats);
+#endif
+    out_buf_ = arena_.Allocate<Sample>(k_block_size);
+    ramp_buf_ = reinterpret_cast<Coeff (*)[k_block_size]>(arena_.Allocate<Coeff>(k_num_ramps * k_block_size));
+
+    os_up1_.Init(arena_.Allocate<float>(Upsampler1::k_storage_floats));
+    os_down1_.Init(arena_.Allocate<float>(Downsampler1::k_storage_floats));
+    os_up2_.Init(arena_.Allocate<float>(Upsampler2::k_storage_floats));
+    os_down2_.Init(arena_.Allocate<float>(Downsampler2::k_storage_floats));
+    os_mid_buf_ = arena_.Allocate<float>(2 * k_block_floats);
+    os_buf_ = arena_.Allocate<float>(4 * k_block_floats);
+
+    click_cache_.Init(arena_.Allocate<Sample>(ClickCacheType::k_storage_samples));
+#ifdef KICK_FREEZE
+    freeze_buf_ = arena_.Allocate<Sample>(k_block_size);
+    hit_cache_.Init(arena_.Allocate<Sample>(HitCacheType::k_storage_samples));
+#endif
+
+#ifdef KICK_SPREAD
+    transient_buf_ = arena_.Allocate<Sample>(k_block_floats);
+    side_buf_ = arena_.Allocate<Sample>(k_block_size);
+    spread_.Init(arena_.Allocate<Sample>(SpreadType::k_storage_samples));
+#else
+    transient_buf_ = nullptr;  // spreadBlock() ist konstant false
+    side_buf_ = nullptr;
+#endif
+  }
+
+  inline void resetOversampling() {
+    os_up1_.Reset();
+    os_down1_.Reset();
+    os_up2_.Reset();
+    os_down2_.Reset();
+  }
+
+#ifndef KICK_FIXED_POINT
+  // Saturator auf 2x bzw. 4x Rate, in-place auf mix_buf_ (Vorverstärkung schon
+  // angewendet). Verzögert das Signal um 15 (2x) bzw. 18.5 (4x) Samples.
+  template <bool k4x>
+  void driveOversampled(size_t frames) {
+    if (k4x) {
+      os_up1_.Process(mix_buf_, os_mid_buf_, frames);
+      os_up2_.Process(os_mid_buf_, os_buf_, frames << 1);
+    } else {
+      os_up1_.Process(mix_buf_, os_buf_, frames);
+    }
+    const size_t os_lanes = (frames * k_num_voices) << (k4x ? 2 : 1);
+    for (size_t i = 0; i < os_lanes; i += 4) {
+      vst1q_f32(os_buf_ + i, Saturator::Process4(vld1q_f32(os_buf_ + i)));
+    }
+    if (k4x) {
+      os_down2_.Process(os_buf_, os_mid_buf_, frames << 1);
+      os_down1_.Process(os_mid_buf_, mix_buf_, frames);
+    } else {
+      os_down1_.Process(os_buf_, mix_buf_, frames);
+    }
+  }
+
+  // Drive (k_drive_*) und Filter auf mix_buf_
+  template <uint8_t kDrive, uint8_t kFilter>
+  void shapeStage(size_t frames) {
+    const size_t lanes = frames * k_num_voices;
+    if (kDrive == k_drive_1x) {
+      const float * pre = ramp_buf_[k_ramp_drive_pre];
+      const float * post = ramp_buf_[k_ramp_drive_post];
+      for (size_t i = 0; i < lanes; i += 4) {
+        const float32x4_t x = Saturator::Process4(vmulq_f32(vld1q_f32(mix_buf_ + i), vld1q_dup_f32(pre + (i >> 2))));
+        vst1q_f32(mix_buf_ + i, vmulq_f32(x, vld1q_dup_f32(post + (i >> 2))));
+      }
+    } else if (kDrive != k_drive_off) {
+      // Vor- und Nachverstärkung sind linear und laufen auf Basisrate
+      const float * pre = ramp_buf_[k_ramp_drive_pre];
+      const float * post = ramp_buf_[k_ramp_drive_post];
+      for (size_t i = 0; i < lanes; i += 4) {
+        vst1q_f32(mix_buf_ + i, vmulq_f32(vld1q_f32(mix_buf_ + i), vld1q_dup_f32(pre + (i >> 2))));
+      }
+      driveOversampled<kDrive == k_drive_4x>(frames);
+      for (size_t i = 0; i < lanes; i += 4) {
+        vst1q_f32(mix_buf_ + i, vmulq_f32(vld1q_f32(mix_buf_ + i), vld1q_dup_f32(post + (i >> 2))));
+      }
+    }
+
+    if (kFilter != k_filter_off) {
+      renderFilter<kFilter == k_filter_24db ? 4 : 2>(mix_buf_, frames);
+    }
+  }
+#endif
+
+  // Kernel-Auswahl; wird mit den Koeffizienten neu bestimmt
+  void selectKernels() {
+#ifdef KICK_FIXED_POINT
+    static const StageFn s_osc_stages[k_num_waves + 1][2] = {
+      {&Synth::oscStageQ<k_wave_sine, false>, &Synth::oscStageQ<k_wave_sine, true>},
+      {&Synth::oscStageQ<k_wave_saw, false>, &Synth::oscStageQ<k_wave_saw, true>},
+      {&Synth::oscStageQ<k_wave_triangle, false>, &Synth::oscStageQ<k_wave_triangle, true>},
+      {&Synth::oscStageQ<k_wave_pulse, false>, &Synth::oscStageQ<k_wave_pulse, true>},
+      {&Synth::oscStageQ<k_wave_noise, false>, &Synth::oscStageQ<k_wave_noise, true>},
+      {&Synth::oscStageQ<k_num_waves, false>, &Synth::oscStageQ<k_num_waves, false>},
+    };
+    // Drive immer auf Basisrate, der Oversampling-Faktor zählt nicht
+    static const StageFn s_shape_stages[2][3] = {
+      {&Synth::shapeStageQ<false, k_filter_off>, &Synth::shapeStageQ<false, k_filter_12db>,
+       &Synth::shapeStageQ<false, k_filter_24db>},
+      {&Synth::shapeStageQ<true, k_filter_off>, &Synth::shapeStageQ<true, k_filter_12db>,
+       &Synth::shapeStageQ<true, k_filter_24db>},
+    };
+#else
+    // OSC2 aus: Wellenform und FM spielen keine Rolle (pruned)
+    static const StageFn s_osc_stages[k_num_waves + 1][2] = {
+      {&Synth::oscStage<k_wave_sine, false>, &Synth::oscStage<k_wave_sine, true>},
+      {&Synth::oscStage<k_wave_saw, false>, &Synth::oscStage<k_wave_saw, true>},
+      {&Synth::oscStage<k_wave_triangle, false>, &Synth::oscStage<k_wave_triangle, true>},
+      {&Synth::oscStage<k_wave_pulse, false>, &Synth::oscStage<k_wave_pulse, true>},
+      {&Synth::oscStage<k_wave_noise, false>, &Synth::oscStage<k_wave_noise, true>},
+      {&Synth::oscStage<k_num_waves, false>, &Synth::oscStage<k_num_waves, false>},
+    };
+    static const StageFn s_shape_stages[4][3] = {
+      {&Synth::shapeStage<k_drive_off, k_filter_off>, &Synth::shapeStage<k_drive_off, k_filter_12db>,
+       &Synth::shapeStage<k_drive_off, k_filter_24db>},
+      {&Synth::shapeStage<k_drive_1x, k_filter_off>, &Synth::shapeStage<k_drive_1x, k_filter_12db>,
+       &Synth::shapeStage<k_drive_1x, k_filter_24db>},
+      {&Synth::shapeStage<k_drive_2x, k_filter_off>, &Synth::shapeStage<k_drive_2x, k_filter_12db>,
+       &Synth::shapeStage<k_drive_2x, k_filter_24db>},
+      {&Synth::shapeStage<k_drive_4x, k_filter_off>, &Synth::shapeStage<k_drive_4x, k_filter_12db>,
+       &Synth::shapeStage<k_drive_4x, k_filter_24db>},
+    };
+#endif
+
+    // Unbekannte Wellenformen klingen als Sinus
+    uint8_t wave = controls_.osc2_waveform < k_num_waves ? controls_.osc2_waveform : static_cast<uint8_t>(k_wave_sine);
+    if (!controls_.osc2_enabled) wave = k_num_waves;
+    // Drive und FM bleiben an, bis ihre Rampe auf 0 angekommen ist
+    const bool fm = controls_.osc2_enabled && (smoother_.Target(k_param_fm_amount) > 0 || smoother_.Value(k_param_fm_amount) > 0);
+    render_.osc_stage = s_osc_stages[wave][fm ? 1 : 0];
+
+    const uint8_t filter = !controls_.filter_enabled ? k_filter_off : (render_.filter_mode_24db ? k_filter_24db : k_filter_12db);
+    const bool drive = smoother_.Target(k_param_drive) > 0 || smoother_.Value(k_param_drive) > 0 ||
+                       (lfoActive() && render_.lfo_dest == k_lfo_drive);
+#ifdef KICK_FIXED_POINT
+    render_.shape_stage = s_shape_stages[drive ? 1 : 0][filter];
+#else
+    render_.shape_stage = s_shape_stages[drive ? k_drive_1x + render_.os_factor : k_drive_off][filter];
+#endif
+  }
+
+  // Stimmenzustand als Structure-of-Arrays: Index = Stimme = NEON-Lane
+  struct Voices {
+    alignas(16) float phase1[k_num_voices];          // Phase des Hauptoszillators
+    alignas(16) float phase2[k_num_voices];          // Phase des zweiten Oszillators
+    alignas(16) float envelope[k_num_voices];        // Amplituden-Envelope
+    alignas(16) float pitch_envelope[k_num_voices];  // Pitch-Envelope für Oszillator 1
+    alignas(16) float osc2_envelope[k_num_voices];   // Separates Envelope für Oszillator 2
+    alignas(16) float velocity[k_num_voices];
+    alignas(16) float filter_state[4][k_num_voices]; // Für einen 4-Pol Filter (24dB/Okt)
+    alignas(16) uint32_t state[k_num_voices];        // k_state_*
+    uint32_t age[k_num_voices];                      // controls_.note_counter beim Anschlag
+    uint32_t click_pos[k_num_voices];                // Lesezeiger im Click-Slot
+    uint32_t click_length[k_num_voices];             // Länge des Transienten, 0 = kein Click
+    uint8_t click_slot[k_num_voices];                // Slot in click_cache_
+    uint32_t frozen_pos[k_num_voices];               // Lesezeiger in hit_cache_ (Bit in render_.frozen_voices)
+    uint8_t note[k_num_voices];
+#ifdef KICK_FIXED_POINT
+    // Zustand des Festkomma-Kernels (fixed.h)
+    alignas(16) uint32_t phase1_q[k_num_voices];          // Q32
+    alignas(16) uint32_t phase2_q[k_num_voices];
+    alignas(16) int32_t envelope_q[k_num_voices];         // Q31
+    alignas(16) int32_t pitch_envelope_q[k_num_voices];
+    alignas(16) int32_t osc2_envelope_q[k_num_voices];
+    alignas(16) int32_t filter_state_q[4][k_num_voices];  // Q27
+    alignas(16) int32_t gain_q[k_num_voices];             // 1.3 * Velocity, Q27
+#endif
+  };
+
+  // Heißer Zustand: liest und schreibt der Render-Thread in jedem Block.
+  // Eigene Cache-Lines, getrennt von den Werten, die der UI-Thread schreibt
+  struct alignas(64) RenderState {
+    Coefficients coeffs;
+    StageFn osc_stage;       // Spezialisierte Kernel des Block-Renderers
+    StageFn shape_stage;
+    uint32_t ramping;        // Bit k_ramp_*: ramp_buf_ enthält gerade eine Rampe
+    uint32_t click_pending;  // Bit = Stimme: angeschlagen, Transient noch nicht zugewiesen
+    uint32_t frozen_voices;  // Bit = Stimme: spielt die Freeze-Aufnahme ab
+    float pulse_width;       // Pulsbreite für Pulse-Wellenform
+    uint8_t sine_tier;       // Sinus-Kernel (k_sine_*), pro Preset wählbar
+    uint8_t os_factor;       // Oversampling der Drive-Stufe (k_os_*), pro Preset wählbar
+    uint8_t hit_voice;       // Stimme, deren Treffer gerade aufgenommen wird
+    float spread_width;      // Stereo-Breite 0 .. 1, 0 = aus
+    float lfo_depth;         // 0 .. 1
+#ifdef KICK_FIXED_POINT
+    uint32_t pulse_width_q;  // Q32
+    int32_t spread_width_q;  // Q31
+    int32_t lfo_depth_q;     // Q31
+#endif
+    uint8_t lfo_dest;        // k_lfo_*
+    bool coeffs_dirty;       // Parameter geändert, coeffs vor dem nächsten Block neu berechnen
+    bool filter_mode_24db;
+    bool spread_block;       // Dieser Block füllt transient_buf_ und side_buf_
+    bool spread_live;        // Verzögerungsleitung enthält Signal
+  };
+
+  // Kalter Zustand: nur bei Anschlag, Kernel-Auswahl oder Abfrage gelesen
+  struct alignas(64) Controls {
+    uint32_t note_counter;  // Zählt Anschläge, für k_steal_oldest
+    uint32_t click_seed;    // Noise-Folge des Clicks, gleich bei jedem Anschlag
+    uint8_t polyphony;
+    uint8_t steal_mode;
+    uint8_t preset_index;
+    uint8_t osc2_enabled;
+    uint8_t osc2_waveform;
+    bool filter_enabled;
+    bool freeze_enabled;
+    bool pristine;  // Seit initialize() nicht gerendert und kein Init()
+  };
+
+  // --- Heiß, ab hier jeder Block ---
+  RenderState render_;
+
+  // Stimmenzustand und Blockpuffer des Block-Renderers (Layout [Frame][Stimme]),
+  // Slices aus arena_, nach layoutArena() nur noch gelesen
+  Voices * voices_;
+#ifdef KICK_FIXED_POINT
+  // Festkomma-Kernel, Layout wie die float-Puffer
+  int32_t * env_q_;        // Q31
+  int32_t * pitch_env_q_;
+  int32_t * osc2_env_q_;
+  int32_t * inc_q_;        // Phaseninkrement Oszillator 1, Q32
+  uint32_t * phase2_q_;
+  int32_t * mix_q_;        // Q27
+  int32_t * tmp_q_;
+#else
+  float * env_buf_;
+  float * pitch_env_buf_;
+  float * osc2_env_buf_;
+  float * freq_buf_;
+  float * phase2_buf_;
+  float * inc2_buf_;    // Phaseninkrement OSC2 pro Sample
+  float * mix_buf_;
+  float * tmp_buf_;
+#endif
+#ifdef KICK_FREEZE
+  Sample * freeze_buf_;  // Summe der eingefrorenen Stimmen, Layout [Frame]
+#endif
+  Sample * out_buf_;     // Mono-Ausgang vor dem Limiter, Layout [Frame]
+  Sample * transient_buf_;  // Click + OSC2 vor Drive und Filter, nur mit Stereo-Breite
+  Sample * side_buf_;       // Verzögerte Transienten, Layout [Frame]
+  float * os_mid_buf_;  // Drive auf 2x Rate (4x: Zwischenstufe)
+  float * os_buf_;
+  Coeff (*ramp_buf_)[k_block_size];  // Koeffizienten pro Frame, k_ramp_*
+
+  // Kontinuierliche Parameter (Index = k_param_*), geglättet
+  ParamSmoother<k_num_params, Param> smoother_;
+  TempoLfo lfo_;
+
+  // --- Kalt, beginnt auf einer neuen Cache-Line ---
+  Controls controls_;
+
+  // Halbband-Filter der Drive-Stufe: Stufe 1 48 <-> 96 kHz, Stufe 2 96 <-> 192 kHz
+  typedef HalfbandUp4<k_hb_2x_pairs, k_block_size> Upsampler1;
+  typedef HalfbandDown4<k_hb_2x_pairs, k_block_size> Downsampler1;
+  typedef HalfbandUp4<k_hb_4x_pairs, 2 * k_block_size> Upsampler2;
+  typedef HalfbandDown4<k_hb_4x_pairs, 2 * k_block_size> Downsampler2;
+  Upsampler1 os_up1_;
+  Downsampler1 os_down1_;
+  Upsampler2 os_up2_;
+  Downsampler2 os_down2_;
+
+  NoiseGenerator4 osc2_noise_;   // Noise-Wellenform von OSC2, eine Folge pro Stimme
+#ifdef KICK_FIXED_POINT
+  typedef ClickCache<k_click_cache_slots, k_click_max_frames, k_block_size, ClickKeyQ> ClickCacheType;
+#else
+  typedef ClickCache<k_click_cache_slots, k_click_max_frames, k_block_size> ClickCacheType;
+#endif
+  ClickCacheType click_cache_;
+
+  typedef HitCache<k_hit_max_frames, k_block_size, Sample> HitCacheType;
+  HitCacheType hit_cache_;
+
+  typedef StereoSpread<k_spread_ring_frames, k_spread_delay_frames, k_block_size, Sample> SpreadType;
+  SpreadType spread_;
+  
+  std::atomic_uint_fast32_t flags_;  // k_flag_*
+
+  // UI bzw. Sequencer -> Render-Thread (postEvent). Die UI-Werte gehören
+  // den Producer-Threads, der Render-Thread liest sie nur beim Resync
+  SpscQueue<ParamEvent, k_event_queue_size> events_;
+  SpscQueue<ParamEvent, k_note_queue_size> notes_;
+#ifdef KICK_NOTE_OFFSETS
+  static constexpr size_t k_schedule_size = k_event_queue_size + k_note_queue_size;
+  ParamEvent schedule_[k_schedule_size];     // Übernommene Ereignisse dieses Render(), nach Offset
+  static_assert(k_schedule_size <= 255, "schedule_count_ ist uint8_t");
+  uint8_t schedule_head_;                    // Nächstes fälliges Ereignis
+  uint8_t schedule_count_;
+#endif
+  std::atomic<int32_t> ui_params_[k_num_params];
+  std::atomic<int32_t> ui_sine_tier_;
+  std::atomic<int32_t> ui_os_factor_;
+  std::atomic<int32_t> ui_freeze_;
+  std::atomic<int32_t> ui_spread_;
+  std::atomic<int32_t> ui_polyphony_;
+  std::atomic<int32_t> ui_steal_mode_;
+  std::atomic<int32_t> ui_tempo_;
+
+  // Preset-Bank des UI-Threads; LoadPreset() legt eine Kopie des Presets in
+  // preset_handoff_, der Render-Thread holt sie bei k_event_preset ab
+  PresetBank<k_num_presets, k_num_user_presets> presets_;
+  PresetHandoff preset_handoff_;
+
+#ifdef KICK_PERF_STATS
+  mutable PerfMeter perf_;  // Last von Render() pro Block, Format() schreibt den Text
+#endif
+
+  // Arena-Bedarf pro Subsystem, jede Slice auf 16 Byte aufgerundet
+  static constexpr size_t k_block_floats = k_block_size * k_num_voices;
+  static constexpr size_t k_voices_bytes = arenaBytes(sizeof(Voices));
+#ifdef KICK_FIXED_POINT
+  static constexpr size_t k_kernel_bytes = 7 * arenaBytes(k_block_floats * sizeof(int32_t));
+#else
+  static constexpr size_t k_kernel_bytes = 8 * arenaBytes(k_block_floats * sizeof(float));
+#endif
+  static constexpr size_t k_block_bytes = k_kernel_bytes + arenaBytes(k_block_size * sizeof(Sample))
+      + arenaBytes(k_num_ramps * k_block_size * sizeof(Coeff));
+  static constexpr size_t k_oversampling_bytes = arenaBytes(Upsampler1::k_storage_floats * sizeof(float))
+      + arenaBytes(Downsampler1::k_storage_floats * sizeof(float))
+      + arenaBytes(Upsampler2::k_storage_floats * sizeof(float))
+      + arenaBytes(Downsampler2::k_storage_floats * sizeof(float))
+      + arenaBytes(2 * k_block_floats * sizeof(float))
+      + arenaBytes(4 * k_block_floats * sizeof(float));
+  static constexpr size_t k_click_bytes = arenaBytes(ClickCacheType::k_storage_samples * sizeof(Sample));
+#ifdef KICK_FREEZE
+  static constexpr size_t k_freeze_bytes = arenaBytes(k_block_size * sizeof(Sample))
+      + arenaBytes(HitCacheType::k_storage_samples * sizeof(Sample));
+#else
+  static constexpr size_t k_freeze_bytes = 0;
+#endif
+#ifdef KICK_SPREAD
+  static constexpr size_t k_spread_bytes = arenaBytes(k_block_floats * sizeof(Sample))
+      + arenaBytes(k_block_size * sizeof(Sample))
+      + arenaBytes(SpreadType::k_storage_samples * sizeof(Sample));
+#else
+  static constexpr size_t k_spread_bytes = 0;
+#endif
+  static constexpr size_t k_arena_bytes =
+      k_voices_bytes + k_block_bytes + k_oversampling_bytes + k_click_bytes + k_freeze_bytes + k_spread_bytes;
+  static_assert(k_arena_bytes <= k_memory_budget, "Puffer überschreiten k_memory_budget");
+
+  StaticArena<k_arena_bytes> arena_;  // Alle Puffer, aufgeteilt in layoutArena()
 };